@@ -4,24 +4,26 @@
  **/
 
 #include <assert.h>
+#include <stdlib.h>
 #include "GTPArchiving.h"
 #include "sgftree.h"
 
 void GTPArchiving_loadSGF( GauGoEngine* engine, int argc, char** argv )
 {
-  // Must have exactly 1 argument
-  if( argc != 2 ){
-    GauGoEngine_sayError( UNKOWN_COMMAND );
+  // File name, and optional move number
+  if( argc != 2 && argc != 3 ){
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
     return;
   }
 
   char* filename = argv[1];
+  int moveNumber = argc == 3 ? atoi( argv[2] ) : 0;
 
   SGFTree tree;
   tree.root = NULL;
   tree.lastnode = NULL;
   if( !sgftree_readfile( &tree, filename ) ){
-    GauGoEngine_sayError( FILE_NOT_FOUND );
+    GauGoEngine_sayError( engine, FILE_NOT_FOUND );
     return;
   }
 
@@ -32,68 +34,95 @@ void GTPArchiving_loadSGF( GauGoEngine* engine, int argc, char** argv )
   engine->options.boardSize = size;
   GauGoEngine_resetBoard( engine );
 
-  // Read and play main variation
-  while( sgftreeForward( &tree ) ){
+  // Read and play main variation, up to the move number
+  int played = 0;
+  while( (moveNumber <= 0 || played < moveNumber-1) 
+	 && sgftreeForward( &tree ) ){
     
     // Pass node
     if( is_pass_node( tree.lastnode, size ) ){
       GauGoEngine_play( engine, PASS );
+      played++;
     }
     
-    else{
-      if( is_move_node( tree.lastnode ) ){
-	INTERSECTION move = 
-	  Board_intersection( 
-			     engine->board, 
-			     get_moveY(tree.lastnode->props, size),
-			     get_moveX(tree.lastnode->props, size)
-			      );
-	// SGF validation check
-	if( !Board_isLegal(engine->board, move) ){
-	  GauGoEngine_sayError(BAD_DATA);
-	}
-	
-	// Must be able to play
-	GauGoEngine_play( engine, move );
-      }
-      else if( is_pass_node( tree.lastnode, size ) ){
-	GauGoEngine_play( engine, PASS );
+    else if( is_move_node( tree.lastnode ) ){
+      INTERSECTION move = 
+	Board_intersection( 
+			   engine->board, 
+			   get_moveY(tree.lastnode->props, size),
+			   get_moveX(tree.lastnode->props, size)
+			    );
+      // SGF validation check
+      if( !Board_isLegal(engine->board, move) ){
+	GauGoEngine_sayError(engine, BAD_DATA);
+	return;
       }
+	
+      GauGoEngine_play( engine, move );
+      played++;
     }
   }
 
   // Success
-  GauGoEngine_saySuccess("");
+  GauGoEngine_saySuccess(engine, "");
 }
 
-void GTPArchiving_saveSGF( GauGoEngine* engine, int argc, char** argv )
+/**
+ * @brief Builds the sgf tree of the game, from the empty board 
+ * to the current position
+ *
+ * @param engine The engine
+ * @param tree Receives the tree (to be freed with sgfFreeNode)
+ **/
+void archiving_gameTree( GauGoEngine* engine, SGFTree* tree )
 {
-  // Must have exactly 1 argument
-  if( argc != 2 ){
-    GauGoEngine_sayError( UNKOWN_COMMAND );
-    return;
-  }
-  
-  char* filename = argv[1];
-  
-  SGFTree tree;
-  tree.root = NULL;
-  tree.lastnode = NULL;
-  sgftreeCreateHeaderNode(&tree, engine->board->size, 6.5f, 0);
+  tree->root = NULL;
+  tree->lastnode = NULL;
+  sgftreeCreateHeaderNode(tree, engine->board->size, engine->options.komi, 0);
 
   Color turn = BLACK;
-  for( int m=0; m<engine->historyLength-1; m++ ) {
+  for( int m=0; m<engine->currentHistoryPos; m++ ) {
     INTERSECTION ints = engine->historyMoves[m];
+    int pass = ints == PASS;
     sgftreeAddPlay(
-		   &tree, 
+		   tree, 
 		   turn, 
-		   Board_intersectionY(engine->board, ints), 
-		   Board_intersectionX(engine->board, ints)
+		   pass ? -1 : Board_intersectionY(engine->board, ints), 
+		   pass ? -1 : Board_intersectionX(engine->board, ints)
 		   );
     turn = turn==BLACK?WHITE:BLACK;
   }
+}
+
+void GTPArchiving_saveSGF( GauGoEngine* engine, int argc, char** argv )
+{
+  // Must have exactly 1 argument
+  if( argc != 2 ){
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
+    return;
+  }
   
+  char* filename = argv[1];
+  
+  SGFTree tree;
+  archiving_gameTree( engine, &tree );
   writesgf(tree.root, argv[1]);
+  sgfFreeNode(tree.root);
+
+  GauGoEngine_saySuccess(engine, "");
+}
+
+int GTPArchiving_writeGame( GauGoEngine* engine, const char* fileName,
+			    const char* blackName, const char* whiteName,
+			    const char* result )
+{
+  SGFTree tree;
+  archiving_gameTree( engine, &tree );
+  sgfAddProperty(tree.root, "PB", blackName);
+  sgfAddProperty(tree.root, "PW", whiteName);
+  sgfOverwriteProperty(tree.root, "RE", result);
 
-  GauGoEngine_saySuccess("");
+  int written = writesgf(tree.root, fileName);
+  sgfFreeNode(tree.root);
+  return written;
 }
@@ -9,7 +9,8 @@
 #include "gauGoEngine.h"
 
 /**
- * @brief Load the main variation of an sgf file
+ * @brief Load the main variation of an sgf file, or its position
+ * before the move number given as second argument (GTP loadsgf)
  **/
 void GTPArchiving_loadSGF( GauGoEngine* engine, int argc, char** argv );
 
@@ -18,4 +19,19 @@ void GTPArchiving_loadSGF( GauGoEngine* engine, int argc, char** argv );
  **/
 void GTPArchiving_saveSGF( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Writes the game, from the empty board to the current 
+ * position, to an sgf file with its players and result
+ *
+ * @param engine The engine
+ * @param fileName The file name
+ * @param blackName Name of the black player
+ * @param whiteName Name of the white player
+ * @param result The result, as sgf writes it ("B+2.5", "W+T", "0")
+ * @return 1 on success, 0 if the file cannot be written
+ **/
+int GTPArchiving_writeGame( GauGoEngine* engine, const char* fileName,
+			    const char* blackName, const char* whiteName,
+			    const char* result );
+
 #endif
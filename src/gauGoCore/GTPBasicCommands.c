@@ -12,182 +12,234 @@
 #include "policies.h"
 #include "stoppers.h"
 #include "hashTable.h"
+#include "scoring.h"
 #include "crash.h"
 
 void GTPBasicCommands_listCommands( GauGoEngine* engine, int argc, char** argv )
 {
-  printf("= ");
-  GauGoEngine_printCommandList(stdout, "%s\n");
-  printf("\n");
-  fflush(stdout);
+  GauGoEngine_sayBegin( engine );
+  GauGoEngine_printCommandList(engine->out, "%s\n");
+  fprintf(engine->out, "\n");
+  fflush(engine->out);
 }
 
 void GTPBasicCommands_name( GauGoEngine* engine, int argc, char** argv )
 {
-  GauGoEngine_saySuccess("GauGo");  
+  GauGoEngine_saySuccess(engine, "GauGo");  
 }
 
 void GTPBasicCommands_protocolversion( GauGoEngine* engine, int argc, char** argv )
 {
-  GauGoEngine_saySuccess("2");
+  GauGoEngine_saySuccess(engine, "2");
 }
 
 void GTPBasicCommands_version( GauGoEngine* engine, int argc, char** argv )
 {
-  GauGoEngine_saySuccess("0.1");
+  GauGoEngine_saySuccess(engine, "0.1");
 }
 
 
-void GTPBasicCommands_play( GauGoEngine* engine, int argc, char** argv )
+/**
+ * @brief Plays a move given by its GTP color and vertex.
+ * If the color is not current turn's color, a pass is played first.
+ *
+ * @param engine The engine
+ * @param color The color
+ * @param vertex The vertex, or pass
+ * @return 1 if the move was played, 0 if it is illegal (or the
+ * history is full)
+ **/
+int GTPBasicCommands_playVertex( GauGoEngine* engine, char* color, char* vertex )
 {
-  // Must be 3-args command included
-  if( argc != 3 ) {
-    GauGoEngine_sayError( UNKOWN_COMMAND );
-    return;
+  // Room in history for a pass and the move
+  if( engine->currentHistoryPos >= HISTORY_LENGTH_MAX-2 ){
+    return 0;
   }
 
   // Pass once if wrong color
-  if( ! ( ((strcmp( argv[1], "w" ) == 0 || (strcmp( argv[1], "W" ) == 0)) 
+  if( ! ( ((strcmp( color, "w" ) == 0 || (strcmp( color, "W" ) == 0)) 
 	   && engine->board->turn == WHITE)
-	  || ((strcmp( argv[1], "b" ) == 0 || (strcmp( argv[1], "B" ) == 0)) 
+	  || ((strcmp( color, "b" ) == 0 || (strcmp( color, "B" ) == 0)) 
 	      && engine->board->turn == BLACK) ) ) {
     GauGoEngine_play(engine, PASS);
   }
 
   // Check for the pass move
-  if( strcmp( argv[2], "pass" ) == 0 || strcmp( argv[2], "PASS" ) == 0 ){
+  if( strcmp( vertex, "pass" ) == 0 || strcmp( vertex, "PASS" ) == 0 ){
     // Pass
     GauGoEngine_play(engine, PASS);
-    GauGoEngine_saySuccess("");
-    return;
+    return 1;
   }
 
   // Check move legality
-  int arglen = strlen( argv[2] );
+  int arglen = strlen( vertex );
   if( arglen < 2 || arglen > 3){
-    GauGoEngine_sayError( ILLEGAL_MOVE );
-    return;
+    return 0;
   }
 
-  INTERSECTION move = Board_intersectionFromName( engine->board, argv[2] );
+  INTERSECTION move = Board_intersectionFromName( engine->board, vertex );
   if( move == -1 || !Board_isLegal( engine->board, move ) ){
-    GauGoEngine_sayError( ILLEGAL_MOVE );
-    return;
+    return 0;
   }
 
   // Play the move
   GauGoEngine_play(engine, move);
-  GauGoEngine_saySuccess("");
+  return 1;
+}
+
+void GTPBasicCommands_play( GauGoEngine* engine, int argc, char** argv )
+{
+  // Must be 3-args command included
+  if( argc != 3 ) {
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
+    return;
+  }
+
+  if( !GTPBasicCommands_playVertex( engine, argv[1], argv[2] ) ){
+    GauGoEngine_sayError( engine, ILLEGAL_MOVE );
+    return;
+  }
+  GauGoEngine_saySuccess(engine, "");
+}
+
+void GTPBasicCommands_playSequence( GauGoEngine* engine, int argc, char** argv )
+{
+  // Color and vertex pairs
+  if( argc < 3 || argc % 2 == 0 ) {
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
+    return;
+  }
+
+  int startPos = engine->currentHistoryPos;
+  for( int a=1; a<argc; a+=2 ){
+    if( !GTPBasicCommands_playVertex( engine, argv[a], argv[a+1] ) ){
+
+      // Back to the starting position
+      GauGoEngine_rewind( engine, startPos );
+
+      char error[64];
+      snprintf( error, sizeof(error), "illegal move %s %s (move %d)", 
+		argv[a], argv[a+1], (a+1)/2 );
+      GauGoEngine_sayErrorCustom( engine, error );
+      return;
+    }
+  }
+  GauGoEngine_saySuccess(engine, "");
 }
 
 void GTPBasicCommands_genmove( GauGoEngine* engine, int argc, char** argv )
 {
   // Must be 2-args command included
   if( argc != 2 ) {
-    GauGoEngine_sayError( UNKOWN_COMMAND );
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
     return;
   }
 
-  // If no legal moves to play, play pass without thinking
-  BoardIterator it;
-  Board_iterator( engine->board, &it );
-  if( Board_mustPass( engine->board, &it ) ){
-    GauGoEngine_play(engine, PASS);
-    GauGoEngine_saySuccess("pass");
+  INTERSECTION move = GauGoEngine_genmove( engine, NULL, NULL );
+
+  char moveStr[5] = { '\0' };
+  if( move == PASS ) strcpy(moveStr, "pass");
+  else Board_intersectionName( engine->board, move, moveStr );
+  
+  GauGoEngine_saySuccess(engine, moveStr);
+}
+
+void GTPBasicCommands_analyze( GauGoEngine* engine, int argc, char** argv )
+{
+  if( argc > 2 ){
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
     return;
   }
 
-  // Initializes new empty tree
-  UCTTree_delete( &engine->lastTree );
-  UCTTree_initialize( 
-		     &engine->lastTree, 
-		     engine->options.treePoolNodeNum,
-		     engine->board);
+  // Interval in centiseconds
+  int interval = argc == 2 ? atoi( argv[1] ) : 100;
+  if( interval <= 0 ){
+    GauGoEngine_sayError( engine, BAD_DATA );
+    return;
+  }
 
-  // Last boards' hash keys
-  HashKey lastBoards[SUPERKO_HISTORY_MAX];
-  int b=0;
-  for( int i=engine->currentHistoryPos; i>=0 && b<SUPERKO_HISTORY_MAX; i-- ){
-    lastBoards[SUPERKO_HISTORY_MAX-(++b)] = engine->history[i].hashKey;
+  // Nothing to analyze
+  if( Board_mustPass( engine->board ) ){
+    GauGoEngine_saySuccess(engine, "");
+    return;
   }
 
-  // UCT search
+  // Search until interrupted, the lines are the response
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "\n");
+  fflush(engine->out);
+
   UCTSearch search;
-  UCTSearch_initialize( &search, engine->board, 
-			&engine->lastTree, &POLICY_pureRandom, 
-			&STOPPER_5ksim, &engine->options, lastBoards );
-  INTERSECTION move = UCTSearch_search( &search );
+  GauGoEngine_initializeSearch( engine, &search, &STOPPER_analyze );
+  search.analysisInterval = interval * 10;
+  search.nextAnalysis = search.analysisInterval;
+  UCTSearch_search( &search );
+  GauGoEngine_searchDone( engine, &search );
 
-  char moveStr[5] = { '\0' };
-  if( move == PASS ){
-    GauGoEngine_play(engine, PASS);
-    strcpy(moveStr, "pass");
-  }
-  else{
-    gauAssert( Board_isLegal( engine->board, move ), engine->board, NULL );
-    
-    // Play move
-    GauGoEngine_play(engine, move);
-    Board_intersectionName( engine->board, move, moveStr );
-  }
-  
-  GauGoEngine_saySuccess(moveStr);
+  fprintf(engine->out, "\n");
+  fflush(engine->out);
 }
 
 void GTPBasicCommands_undo( GauGoEngine* engine, int argc, char** argv )
 {
   GauGoEngine_undo( engine );
-  GauGoEngine_saySuccess("");
+  GauGoEngine_saySuccess(engine, "");
 }
 
 void GTPBasicCommands_redo( GauGoEngine* engine, int argc, char** argv )
 {
   GauGoEngine_redo( engine );
-  GauGoEngine_saySuccess("");
+  GauGoEngine_saySuccess(engine, "");
 }
 
 void GTPBasicCommands_quit( GauGoEngine* engine, int argc, char** argv )
 {
-  GauGoEngine_saySuccess("");
-  exit(0);
+  GauGoEngine_saySuccess(engine, "");
+  engine->quitRequested = 1;
+}
+
+void GTPBasicCommands_stop( GauGoEngine* engine, int argc, char** argv )
+{
+  // The command being executed was interrupted when the stop was read
+  GauGoEngine_saySuccess(engine, "");
 }
 
 void GTPBasicCommands_printboard( GauGoEngine* engine, int argc, char** argv )
 {
-  printf("= ");
-  Board_print( engine->board, stdout, 1 );
-  printf("\n");
-  fflush(stdout);
+  GauGoEngine_sayBegin( engine );
+  Board_print( engine->board, engine->out, 1 );
+  fprintf(engine->out, "\n");
+  fflush(engine->out);
 }
 
 void GTPBasicCommands_boardsize( GauGoEngine* engine, int argc, char** argv )
 {
   if( argc != 2 ){
-    GauGoEngine_sayError( UNKOWN_COMMAND );
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
     return;
   }
 
   int size = atoi( argv[1] );
   if( size < 4 || size > 19 ){
-    GauGoEngine_sayError( INVALID_SIZE );
+    GauGoEngine_sayError( engine, INVALID_SIZE );
     return;
   }
   
   engine->options.boardSize = size;
   GauGoEngine_resetBoard( engine );
-  GauGoEngine_saySuccess("");
+  GauGoEngine_saySuccess(engine, "");
 }
 
 void GTPBasicCommands_komi( GauGoEngine* engine, int argc, char** argv )
 {
   // Must be 2-args command included
   if( argc != 2 ) {
-    GauGoEngine_sayError( UNKOWN_COMMAND );
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
     return;
   }
 
   engine->options.komi = atof(argv[1]);
-  GauGoEngine_saySuccess("");
+  GauGoEngine_saySuccess(engine, "");
 }
 
 void GTPBasicCommands_clearboard( GauGoEngine* engine, int argc, char** argv )
@@ -198,16 +250,13 @@ void GTPBasicCommands_clearboard( GauGoEngine* engine, int argc, char** argv )
 
   // Reset board
   GauGoEngine_resetBoard( engine );
-  GauGoEngine_saySuccess("");
+  GauGoEngine_saySuccess(engine, "");
 }
 
 void GTPBasicCommands_finalscore( GauGoEngine* engine, int argc, char** argv )
 {
-  BoardIterator it;
-  Board_iterator( engine->board, &it );
-  int score = Board_trompTaylorScore( engine->board, &it );
-
-  float finalScore = score - engine->options.komi;
+  float finalScore = Scoring_finalScore( engine->board, engine->options.komi,
+					 engine->options.scoringPlayouts );
   char scoreBuf[8];
   if( finalScore < 0 ){
     sprintf(scoreBuf, "W+%2.1f", -finalScore);
@@ -217,5 +266,50 @@ void GTPBasicCommands_finalscore( GauGoEngine* engine, int argc, char** argv )
     sprintf(scoreBuf, "0");
   }
   
-  GauGoEngine_saySuccess(scoreBuf);
+  GauGoEngine_saySuccess(engine, scoreBuf);
+}
+
+void GTPBasicCommands_finalstatuslist( GauGoEngine* engine, int argc, char** argv )
+{
+  if( argc != 2 ){
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
+    return;
+  }
+
+  StoneStatus status;
+  if( strcmp( argv[1], "alive" ) == 0 ) status = STATUS_ALIVE;
+  else if( strcmp( argv[1], "dead" ) == 0 ) status = STATUS_DEAD;
+  else if( strcmp( argv[1], "seki" ) == 0 ) status = STATUS_SEKI;
+  else {
+    GauGoEngine_sayErrorCustom(engine, "invalid status");
+    return;
+  }
+
+  // Estimate dead stones and resulting ownership
+  Bitboard dead;
+  Color owner[MAX_INTERSECTION_NUM];
+  Scoring_estimateDeadStones( engine->board, engine->options.komi, 
+			      engine->options.scoringPlayouts, &dead );
+  Board_areaOwnership( engine->board, &dead, owner );
+
+  // One stone per line
+  GauGoEngine_sayBegin( engine );
+  int listed = 0;
+  BoardIterator it;
+  Board_iterator( engine->board, &it );
+  INTERSECTION intersection;
+  for( INTERSECTIONS((&it)) ){
+    intersection = INTERSECTIONI((&it));
+    if( engine->board->intersectionMap[intersection] > WHITE ) continue;
+
+    if( Scoring_stoneStatus( engine->board, &dead, owner, intersection ) 
+	== status ){
+      char name[5];
+      Board_intersectionName( engine->board, intersection, name );
+      fprintf(engine->out, "%s%s", listed++ ? "\n" : "", name);
+    }
+  }
+
+  fprintf(engine->out, "\n\n");
+  fflush(engine->out);
 }
@@ -37,6 +37,15 @@ void GTPBasicCommands_version( GauGoEngine* engine, int argc, char** argv );
  **/
 void GTPBasicCommands_play( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Plays a sequence of moves given as color and vertex pairs,
+ * e.g. "play_sequence b D4 w Q16 b pass", with a single response.
+ * Moves are played as by the play command.  If one of them is 
+ * illegal, the moves already played are undone, and the error 
+ * tells which move it was.
+ **/
+void GTPBasicCommands_playSequence( GauGoEngine* engine, int argc, char** argv );
+
 /**
  * @brief Generate a move for the current turn.
  * The specified color must be current's turn color. 
@@ -44,6 +53,15 @@ void GTPBasicCommands_play( GauGoEngine* engine, int argc, char** argv );
  **/
 void GTPBasicCommands_genmove( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Analyzes the current position: searches until interrupted
+ * by a stop or quit command,
+ * printing the statistics of the root children in one line every
+ * interval centiseconds (argument, default 100), as long as the 
+ * search goes on.  See UCTSearch_printAnalysis for the line format.
+ **/
+void GTPBasicCommands_analyze( GauGoEngine* engine, int argc, char** argv );
+
 /**
  * @brief Undos the last move
  **/
@@ -55,10 +73,19 @@ void GTPBasicCommands_undo( GauGoEngine* engine, int argc, char** argv );
 void GTPBasicCommands_redo( GauGoEngine* engine, int argc, char** argv );
 
 /**
- * @brief Exists the program
+ * @brief Ends the session: the program exits after the response
  **/
 void GTPBasicCommands_quit( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Interrupts the running search, which then answers at once
+ * with the best move found so far.  The interruption is done by the
+ * GTP reader thread as soon as the command is received, and only
+ * applies to the command being executed: commands queued before the
+ * stop run in full.
+ **/
+void GTPBasicCommands_stop( GauGoEngine* engine, int argc, char** argv );
+
 /**
  * @brief Print the board for debugging purposes.
  **/
@@ -80,9 +107,15 @@ void GTPBasicCommands_komi( GauGoEngine* engine, int argc, char** argv );
 void GTPBasicCommands_clearboard( GauGoEngine* engine, int argc, char** argv );
 
 /**
- * @brief Calculates the score (Tromp-Taylor) of a finished game.
- * If the game is not finished, behaviour is undefined.
+ * @brief Calculates the area score of the game, after removing the
+ * dead stones estimated by random playouts.
  **/
 void GTPBasicCommands_finalscore( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Lists the stones with the specified final status
+ * (alive, dead or seki), as estimated by random playouts.
+ **/
+void GTPBasicCommands_finalstatuslist( GauGoEngine* engine, int argc, char** argv );
+
 #endif
@@ -5,6 +5,7 @@
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 #include "GTPBench.h"
 #include "board.h"
 #include "uctTree.h"
@@ -17,24 +18,209 @@ void GTPBench_playoutBench( GauGoEngine* engine, int argc, char** argv )
 {
   Timer timer;
 
-  Board boardCopy;
-  Board_copy( &boardCopy, engine->board );  
-  BoardIterator it;
-  Board_iterator(&boardCopy, &it);
+  // Policy from options, or given as argument
+  PolicyId policyId = argc > 1 ? 
+    Options_policyId(argv[1]) : engine->options.policy;
+  if( policyId == POLICY_ID_UNKNOWN ){
+    GauGoEngine_sayErrorCustom( engine, "unknown policy" );
+    return;
+  }
+
+  Policy policy;
+  if( !Policy_initialize( &policy, policyId ) ){
+    GauGoEngine_sayErrorCustom( engine, "out of memory" );
+    return;
+  }
 
-  // Do 30k po
-  int blackWins = 0;
-  unsigned char playedMoves[MAX_INTERSECTION_NUM];
+  // Mercy threshold from options, or given as argument
+  policy.mercyThreshold = argc > 2 ? atoi(argv[2]) 
+    : Options_mercyThreshold( &engine->options, engine->board->size );
+
+  // Do 100k po
+  static __thread PlayoutStats stats;
+  PlayoutStats_clear( &stats );
   
+  Timer_initialize( &timer );
+  Timer_start( &timer );
+  Policy_playouts( &policy, engine->board, 6.5f, BENCH_POS, &stats );
+
+  int pps = BENCH_POS*1e9 / Timer_getElapsedNanos(&timer);
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "%dpps\nwr=%f \nlength=%.1f \n\n", 
+	  pps, (stats.blackWins/BENCH_POS),
+	  (float)policy.moves / policy.playouts);
+  Policy_teardown( &policy );
+  fflush(engine->out);
+}
+
+#define PROBEBENCH_POS 20000
+
+/**
+ * @brief Function called after every move of the probe benchmarks
+ * @return The number of probes made
+ **/
+typedef int (*BENCH_PROBE)(Board* board, INTERSECTION move);
+
+/**
+ * @brief Plays PROBEBENCH_POS random playouts, calling the probe
+ * (if not NULL) after each move
+ *
+ * @param board The starting position
+ * @param probe The probe
+ * @param probes Receives the total number of probes made
+ * @return The elapsed time in milliseconds
+ **/
+int GTPBench_probeRun( Board* board, BENCH_PROBE probe, long* probes )
+{
+  Timer timer;
+  Board boardCopy;
+  Rng rng;
+
+  // Same playouts for every probe
+  *probes = 0;
+  Rng_seed( &rng, 0 );
+  Timer_initialize( &timer );
   Timer_start( &timer );
-  for( int po=0; po<BENCH_POS; po++ ){
-    Board_copy( &boardCopy, engine->board );
-    if( POLICY_pureRandom( &boardCopy, &it, 6.5f, playedMoves ) == BLACK ){
-      blackWins++;
+  for( int po=0; po<PROBEBENCH_POS; po++ ){
+    Board_copy( &boardCopy, board );
+    int passed = 0;
+    for( int m=0; m<PLAYOUT_MOVES_MAX && passed<2; m++ ){
+      INTERSECTION move = Board_randomPlayable( &boardCopy, &rng );
+      if( move == PASS ){
+	Board_pass( &boardCopy );
+	passed++;
+	continue;
+      }
+      Board_play( &boardCopy, move );
+      passed = 0;
+
+      if( probe ) *probes += probe( &boardCopy, move );
+    }
+  }
+  return Timer_getElapsedTime( &timer );
+}
+
+/**
+ * @brief Lists the liberties of the last move's group
+ **/
+int GTPBench_exactLibertiesProbe( Board* board, INTERSECTION move )
+{
+  INTERSECTION libs[4];
+  Board_liberties( board, board->groupMap[move], libs, 4 );
+  return 1;
+}
+
+/**
+ * @brief Lists the liberties of the last move's group by stone browsing
+ **/
+int GTPBench_scanLibertiesProbe( Board* board, INTERSECTION move )
+{
+  INTERSECTION libs[4];
+  Board_scanLiberties( board, board->groupMap[move], libs, 4 );
+  return 1;
+}
+
+/**
+ * @brief Reads ladders for the groups around the last move
+ * that have one or two liberties
+ **/
+int GTPBench_ladderProbe( Board* board, INTERSECTION move )
+{
+  int probes = 0;
+  int neigh;
+  for( NEIGHBORS(move) ){
+    neigh = NEIGHI(board, move);
+    if( board->intersectionMap[neigh] > WHITE ) continue;
+    if( board->groups[board->groupMap[neigh]].libertiesNum <= 2 ){
+      Board_ladderCapturable( board, board->groupMap[neigh] );
+      probes++;
     }
   }
+  return probes;
+}
+
+void GTPBench_libertiesBench( GauGoEngine* engine, int argc, char** argv )
+{
+  long probes;
+  int none = GTPBench_probeRun( engine->board, NULL, &probes );
+  int exact = GTPBench_probeRun( engine->board, 
+				 &GTPBench_exactLibertiesProbe, &probes );
+  int scan = GTPBench_probeRun( engine->board, 
+				&GTPBench_scanLibertiesProbe, &probes );
+
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "playouts only: %dms\nexact: %dms\nscan: %dms\n\n", 
+	  none, exact, scan);
+  fflush(engine->out);
+}
+
+void GTPBench_ladderBench( GauGoEngine* engine, int argc, char** argv )
+{
+  long probes;
+  int none = GTPBench_probeRun( engine->board, NULL, &probes );
+  int ladder = GTPBench_probeRun( engine->board, 
+				  &GTPBench_ladderProbe, &probes );
+
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "%ld readings in %dms (%.0fns each)\n\n", 
+	  probes, ladder-none, (ladder-none)*1e6 / (probes ? probes : 1));
+  fflush(engine->out);
+}
+
+#define GTPBENCH_COMMANDS 100000
+
+void GTPBench_gtpBench( GauGoEngine* engine, int argc, char** argv )
+{
+  int commands = argc > 1 ? atoi(argv[1]) : GTPBENCH_COMMANDS;
+
+  // Two empty intersections to play on
+  INTERSECTION moves[2];
+  int movesNum = 0;
+  for( int i=0; i<engine->board->emptiesNum && movesNum<2; i++ ){
+    INTERSECTION empty = engine->board->empties[i];
+    if( Board_isLegal( engine->board, empty ) ) moves[movesNum++] = empty;
+  }
+  if( movesNum < 2 ){
+    GauGoEngine_sayErrorCustom( engine, "no room to play" );
+    return;
+  }
+
+  // Command lines: both moves, then undo them
+  char lines[4][32];
+  char name[5];
+  Color turn = engine->board->turn;
+  for( int m=0; m<2; m++ ){
+    Board_intersectionName( engine->board, moves[m], name );
+    sprintf( lines[m], "%d play %c %s", m+1, 
+	     (turn == BLACK) == (m == 0) ? 'b' : 'w', name );
+  }
+  strcpy( lines[2], "3 undo" );
+  strcpy( lines[3], "4 undo" );
+
+  // Engine copy, without tree, answering to nowhere
+  GauGoEngine bench;
+  bench = *engine;
+  bench.board = &bench.position;
+  UCTTree_initializeEmpty( &bench.lastTree );
+  bench.out = fopen( "/dev/null", "w" );
+  if( !bench.out ){
+    GauGoEngine_sayErrorCustom( engine, "cannot open /dev/null" );
+    return;
+  }
+
+  Timer timer;
+  Timer_initialize( &timer );
+  Timer_start( &timer );
+  char line[32];
+  for( int c=0; c<commands; c++ ){
+    strcpy( line, lines[c%4] );
+    GauGoEngine_receiveGTPLine( &bench, line );
+  }
+  long long nanos = Timer_getElapsedNanos( &timer );
+  fclose( bench.out );
 
-  int pps = BENCH_POS*1000 / Timer_getElapsedTime(&timer);
-  printf("= %dpps\nwr=%f \n\n", pps, (blackWins/BENCH_POS));
-  fflush(stdout);
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "%.0f commands/s (%.0fns each)\n\n", 
+	  commands * 1e9 / nanos, (double)nanos / commands);
+  fflush(engine->out);
 }
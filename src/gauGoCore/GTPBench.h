@@ -10,8 +10,34 @@
 
 /**
  * @brief Performs a live benchmark of random playouts
- * without tree search
+ * without tree search, with the policy from the options or
+ * the one given as argument ("random", "patterns" or "mogo"), and
+ * the mercy threshold from the options or given as second argument 
+ * (in stones).  Reports playouts per second, black's win rate and
+ * the average playout length.
  **/
 void GTPBench_playoutBench( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Benchmarks liberty listing during random playouts:
+ * exact liberty sets against browsing the stones of the group
+ * (both browse the stones unless EXACT_LIBERTIES is defined)
+ **/
+void GTPBench_libertiesBench( GauGoEngine* engine, int argc, char** argv );
+
+/**
+ * @brief Benchmarks ladder reading during random playouts,
+ * for groups around each move with one or two liberties
+ **/
+void GTPBench_ladderBench( GauGoEngine* engine, int argc, char** argv );
+
+/**
+ * @brief Benchmarks GTP command processing: parsing, dispatch and
+ * execution of play and undo command lines (with ids) on a copy of
+ * the engine, with responses discarded.  The number of command 
+ * lines can be given as argument (default 100000).  Reports 
+ * commands per second.
+ **/
+void GTPBench_gtpBench( GauGoEngine* engine, int argc, char** argv );
+
 #endif
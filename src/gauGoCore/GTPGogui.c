@@ -9,27 +9,30 @@
 #include "GTPGogui.h"
 #include "board.h"
 #include "uctTree.h"
+#include "policies.h"
 
 // gogui_analyze commands declaration
 const char* goguiAnalyzeCommands[] = {
   "gfx/NodeInfo/gogui-nodeinfo",
   "gfx/PV/gogui-pv",
+  "gfx/Ownership/gogui-ownership",
+  "gfx/Criticality/gogui-criticality",
   NULL
 };
 
 void GTPGogui_analyzecommands( GauGoEngine* engine, int argc, char** argv )
 {
-  printf("= ");
+  GauGoEngine_sayBegin( engine );
 
   int i=0;
   while( goguiAnalyzeCommands[i] != NULL ){
-    printf("%s", goguiAnalyzeCommands[i]);
-    printf("\n");
+    fprintf(engine->out, "%s", goguiAnalyzeCommands[i]);
+    fprintf(engine->out, "\n");
     i++;
   }
 
-  printf("\n");
-  fflush(stdout);
+  fprintf(engine->out, "\n");
+  fflush(engine->out);
 }
 
 int uctNodeCmp(const void* a, const void* b){
@@ -38,7 +41,7 @@ int uctNodeCmp(const void* a, const void* b){
 
 void GTPGogui_nodeinfo( GauGoEngine* engine, int argc, char** argv )
 {
-  printf("= ");
+  GauGoEngine_sayBegin( engine );
 
   UCTNode* pos = GauGoEngine_getTreePos( engine );
   if( pos ){
@@ -56,33 +59,36 @@ void GTPGogui_nodeinfo( GauGoEngine* engine, int argc, char** argv )
     for( int i=0; i<sortedNum; i++ ) {
       char intName[5];
       Board_intersectionName( engine->board, sortedNodes[i]->move, intName );
-      printf( "TEXT %s: (wr)%d/%d (amaf)%d/%d (uct)%f\n", 
-	      intName, 
-	      sortedNodes[i]->winsBlack, 
-	      sortedNodes[i]->played,
-	      sortedNodes[i]->AMAFwinsBlack,
-	      sortedNodes[i]->AMAFplayed,
-	      UCTNode_evaluateUCT( sortedNodes[i], pos, engine->board->turn, 0.44f )
-	      );
+      fprintf( engine->out, 
+	       "TEXT %s: (wr)%d/%d (prior)%d/%d (amaf)%d/%d (uct)%f\n", 
+	       intName, 
+	       sortedNodes[i]->winsBlack, 
+	       sortedNodes[i]->played,
+	       sortedNodes[i]->priorWinsBlack, 
+	       sortedNodes[i]->priorPlayed,
+	       sortedNodes[i]->AMAFwinsBlack,
+	       sortedNodes[i]->AMAFplayed,
+	       UCTNode_evaluateUCT( sortedNodes[i], pos, engine->board->turn, 0.44f )
+	       );
       if( i<5 ){
-	printf( "LABEL %s %d\n", intName, i+1 );
+	fprintf( engine->out, "LABEL %s %d\n", intName, i+1 );
       }
     }
   }
 
-  printf("\n\n");
-  fflush(stdout);
+  fprintf(engine->out, "\n\n");
+  fflush(engine->out);
 }
 
 void GTPGogui_pv( GauGoEngine* engine, int argc, char** argv )
 {
-  printf("= ");
+  GauGoEngine_sayBegin( engine );
   
   // Gets pv
   INTERSECTION pv[MAX_INTERSECTION_NUM];
   UCTNode* pos = GauGoEngine_getTreePos( engine );
   if( pos ){
-    printf("VAR ");
+    fprintf(engine->out, "VAR ");
     UCTTree_getPv( pv, pos );
     
     Color turn = engine->board->turn;
@@ -91,12 +97,67 @@ void GTPGogui_pv( GauGoEngine* engine, int argc, char** argv )
       
       char str[5];
       Board_intersectionName( engine->board, pv[i], str );
-      printf("%c %s ", turn==BLACK?'b':'w', str);
+      fprintf(engine->out, "%c %s ", turn==BLACK?'b':'w', str);
       
       turn = !turn;
     }
   }
 
-  printf("\n\n");
-  fflush(stdout);
+  fprintf(engine->out, "\n\n");
+  fflush(engine->out);
+}
+
+/**
+ * @brief Obtains playout statistics for the current position
+ **/
+PlayoutStats* GTPGogui_stats( GauGoEngine* engine )
+{
+  if( engine->lastStats.playouts 
+      && engine->lastStatsHash == engine->board->hashKey ){
+    return &engine->lastStats;
+  }
+
+  static __thread PlayoutStats stats;
+  PlayoutStats_clear( &stats );
+  Policy_playouts( GauGoEngine_policy( engine ), engine->board, 
+		   engine->options.komi, engine->options.scoringPlayouts, 
+		   &stats );
+  return &stats;
+}
+
+/**
+ * @brief Prints an INFLUENCE gfx command for some values
+ * of all intersections
+ **/
+void GTPGogui_influence( GauGoEngine* engine, PlayoutStats* stats, 
+			 float (*value)(PlayoutStats*, INTERSECTION),
+			 float scale )
+{
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "INFLUENCE");
+
+  BoardIterator it;
+  Board_iterator( engine->board, &it );
+  INTERSECTION intersection;
+  for( INTERSECTIONS((&it)) ){
+    intersection = INTERSECTIONI((&it));
+    char str[5];
+    Board_intersectionName( engine->board, intersection, str );
+    fprintf(engine->out, " %s %.2f", str, value( stats, intersection ) * scale);
+  }
+
+  fprintf(engine->out, "\n\n");
+  fflush(engine->out);
+}
+
+void GTPGogui_ownership( GauGoEngine* engine, int argc, char** argv )
+{
+  GTPGogui_influence( engine, GTPGogui_stats( engine ), 
+		      &PlayoutStats_ownership, 1.0f );
+}
+
+void GTPGogui_criticality( GauGoEngine* engine, int argc, char** argv )
+{
+  GTPGogui_influence( engine, GTPGogui_stats( engine ), 
+		      &PlayoutStats_criticality, 2.0f );
 }
@@ -28,4 +28,20 @@ void GTPGogui_pv( GauGoEngine* engine, int argc, char** argv );
  **/
 void GTPGogui_nodeinfo( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Outputs the Monte-Carlo ownership of all intersections 
+ * in gogui gfx format (from 1 black to -1 white).  Statistics come 
+ * from the last search if it was made from the current position, 
+ * otherwise from new playouts.
+ **/
+void GTPGogui_ownership( GauGoEngine* engine, int argc, char** argv );
+
+/**
+ * @brief Outputs the criticality of all intersections in gogui gfx
+ * format, scaled from [-0.5, 0.5] to [-1, 1].  Statistics come from
+ * the last search if it was made from the current position, otherwise
+ * from new playouts.
+ **/
+void GTPGogui_criticality( GauGoEngine* engine, int argc, char** argv );
+
 #endif
@@ -14,56 +14,83 @@
 void GTPPatterns_pattern( GauGoEngine* engine, int argc, char** argv )
 {
   if( argc<2 ){
-    GauGoEngine_sayErrorCustom("must provide an intersection name");
+    GauGoEngine_sayErrorCustom(engine, "must provide an intersection name");
     return;
   }
   
   INTERSECTION intersection = 
     Board_intersectionFromName( engine->board, argv[1] );
   if( intersection < 0 ){
-    GauGoEngine_sayErrorCustom("invalid intersection name");
+    GauGoEngine_sayErrorCustom(engine, "invalid intersection name");
     return;
   }
   
   int patt = engine->board->patterns3x3[intersection];
-  printf("= %x (%d|%d|%d|%d)(", 
-	 patt,
-	 (patt>>19)&1,
-	 (patt>>18)&1,
-	 (patt>>17)&1,
-	 (patt>>16)&1
-	 );
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "%x (%d|%d|%d|%d)(", 
+	  patt,
+	  (patt>>19)&1,
+	  (patt>>18)&1,
+	  (patt>>17)&1,
+	  (patt>>16)&1
+	  );
 
   for( int i=7; i>=0; i-- ){
-    printf("%d", (patt&(1<<(i*2+1)))>0);
-    printf("%d", (patt&(1<<(i*2)))>0);
-    if( i!=0 ) printf("-");
+    fprintf(engine->out, "%d", (patt&(1<<(i*2+1)))>0);
+    fprintf(engine->out, "%d", (patt&(1<<(i*2)))>0);
+    if( i!=0 ) fprintf(engine->out, "-");
   }
 
-  printf(")\n\n");
-  fflush(stdout);
+  fprintf(engine->out, ")\n\n");
+  fflush(engine->out);
 }
 
 void GTPPatterns_patternInfo( GauGoEngine* engine, int argc, char** argv )
 {
   if( argc<2 ){
-    GauGoEngine_sayErrorCustom("must provide an intersection name");
+    GauGoEngine_sayErrorCustom(engine, "must provide an intersection name");
     return;
   }
   
   INTERSECTION intersection = 
     Board_intersectionFromName( engine->board, argv[1] );
   if( intersection < 0 ){
-    GauGoEngine_sayErrorCustom("invalid intersection name");
+    GauGoEngine_sayErrorCustom(engine, "invalid intersection name");
     return;
   }
   
   int patt = engine->board->patterns3x3[intersection];
-  printf("= %x (%d-%d-%d)\n\n", 
-	 p3x3info[patt],
-	 p3x3info[patt]>>2,
-	 (p3x3info[patt]&2)>0,
-	 (p3x3info[patt]&1)>0
-	 );
-  fflush(stdout);
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "%x (%d-%d-%d)\n\n", 
+	  p3x3info[patt],
+	  p3x3info[patt]>>2,
+	  (p3x3info[patt]&2)>0,
+	  (p3x3info[patt]&1)>0
+	  );
+  fflush(engine->out);
+}
+
+void GTPPatterns_ladder( GauGoEngine* engine, int argc, char** argv )
+{
+  if( argc<2 ){
+    GauGoEngine_sayErrorCustom(engine, "must provide an intersection name");
+    return;
+  }
+  
+  INTERSECTION intersection = 
+    Board_intersectionFromName( engine->board, argv[1] );
+  if( intersection < 0 ){
+    GauGoEngine_sayErrorCustom(engine, "invalid intersection name");
+    return;
+  }
+  if( engine->board->intersectionMap[intersection] > WHITE ){
+    GauGoEngine_sayErrorCustom(engine, "no stone at intersection");
+    return;
+  }
+
+  GRID group = engine->board->groupMap[intersection];
+  GauGoEngine_sayBegin( engine );
+  fprintf(engine->out, "%s\n\n", Board_ladderCapturable( engine->board, group ) ?
+	  "captured" : "escapes");
+  fflush(engine->out);
 }
@@ -21,4 +21,10 @@ void GTPPatterns_pattern( GauGoEngine* engine, int argc, char** argv );
  **/
 void GTPPatterns_patternInfo( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Reads out the ladder of the group at given intersection
+ * (captured/escapes)
+ **/
+void GTPPatterns_ladder( GauGoEngine* engine, int argc, char** argv );
+
 #endif
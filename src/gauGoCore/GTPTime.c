@@ -0,0 +1,94 @@
+/**
+ * @file  GTPTime.c
+ * @brief Implementation of the GTP time control commands
+ *
+ **/
+
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include "GTPTime.h"
+
+/**
+ * @brief Reads a GTP color
+ *
+ * @return BLACK, WHITE, or EMPTY if it is not a color
+ **/
+Color GTPTime_color( const char* color )
+{
+  if( strcasecmp( color, "b" ) == 0 || strcasecmp( color, "black" ) == 0 ){
+    return BLACK;
+  }
+  if( strcasecmp( color, "w" ) == 0 || strcasecmp( color, "white" ) == 0 ){
+    return WHITE;
+  }
+  return EMPTY;
+}
+
+void GTPTime_timeSettings( GauGoEngine* engine, int argc, char** argv )
+{
+  if( argc != 4 ){
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
+    return;
+  }
+
+  int mainTime = atoi( argv[1] );
+  int byoYomiTime = atoi( argv[2] );
+  int byoYomiStones = atoi( argv[3] );
+
+  if( byoYomiTime > 0 && byoYomiStones == 0 ){
+    TimeControl_initialize( &engine->timeControl );
+  }
+  else{
+    TimeControl_set( &engine->timeControl, mainTime*1000, BYOYOMI_CANADIAN,
+		     byoYomiTime*1000, byoYomiStones );
+  }
+  GauGoEngine_saySuccess(engine, "");
+}
+
+void GTPTime_kgsTimeSettings( GauGoEngine* engine, int argc, char** argv )
+{
+  if( argc < 2 ){
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
+    return;
+  }
+
+  if( strcmp( argv[1], "none" ) == 0 ){
+    TimeControl_initialize( &engine->timeControl );
+  }
+  else if( strcmp( argv[1], "absolute" ) == 0 && argc == 3 ){
+    TimeControl_set( &engine->timeControl, atoi(argv[2])*1000, 
+		     BYOYOMI_NONE, 0, 0 );
+  }
+  else if( strcmp( argv[1], "byoyomi" ) == 0 && argc == 5 ){
+    TimeControl_set( &engine->timeControl, atoi(argv[2])*1000, 
+		     BYOYOMI_JAPANESE, atoi(argv[3])*1000, atoi(argv[4]) );
+  }
+  else if( strcmp( argv[1], "canadian" ) == 0 && argc == 5 ){
+    TimeControl_set( &engine->timeControl, atoi(argv[2])*1000, 
+		     BYOYOMI_CANADIAN, atoi(argv[3])*1000, atoi(argv[4]) );
+  }
+  else{
+    GauGoEngine_sayError( engine, BAD_DATA );
+    return;
+  }
+  GauGoEngine_saySuccess(engine, "");
+}
+
+void GTPTime_timeLeft( GauGoEngine* engine, int argc, char** argv )
+{
+  if( argc != 4 ){
+    GauGoEngine_sayError( engine, UNKOWN_COMMAND );
+    return;
+  }
+
+  Color color = GTPTime_color( argv[1] );
+  if( color == EMPTY ){
+    GauGoEngine_sayError( engine, WRONG_COLOR );
+    return;
+  }
+
+  TimeControl_setClock( &engine->timeControl, color, 
+			atof(argv[2])*1000, atoi(argv[3]) );
+  GauGoEngine_saySuccess(engine, "");
+}
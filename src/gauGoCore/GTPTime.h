@@ -0,0 +1,31 @@
+/**
+ * @file  GTPTime.h
+ * @brief Implementation of the GTP time control commands
+ *
+ **/
+#ifndef GTP_TIME_H
+#define GTP_TIME_H
+
+#include "gauGoEngine.h"
+
+/**
+ * @brief Sets canadian byo-yomi time settings:
+ * main time, byo-yomi time and stones per period, in seconds.
+ * A byo-yomi time with no stones means no time limit.
+ **/
+void GTPTime_timeSettings( GauGoEngine* engine, int argc, char** argv );
+
+/**
+ * @brief Sets the time settings in the KGS format:
+ * "none", "absolute main", "byoyomi main period periods" 
+ * or "canadian main period stones", in seconds
+ **/
+void GTPTime_kgsTimeSettings( GauGoEngine* engine, int argc, char** argv );
+
+/**
+ * @brief Sets a player's clock: color, time left in seconds 
+ * and stones (or periods) left, 0 while in main time
+ **/
+void GTPTime_timeLeft( GauGoEngine* engine, int argc, char** argv );
+
+#endif
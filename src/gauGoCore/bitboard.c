@@ -0,0 +1,71 @@
+/**
+ * @file bitboard.c
+ * @brief Bitboard implementation
+ *
+ **/
+
+#include "bitboard.h"
+
+#include <string.h>
+
+void Bitboard_clear(Bitboard* bb)
+{
+  memset(bb->bits, 0, sizeof(bb->bits));
+}
+
+void Bitboard_dilate(Bitboard* dst, const Bitboard* src, int rowOffset)
+{
+  for( int w=0; w<BITBOARD_WORDS; w++ ){
+    unsigned long long prev = w > 0 ? src->bits[w-1] : 0;
+    unsigned long long next = w < BITBOARD_WORDS-1 ? src->bits[w+1] : 0;
+    unsigned long long cur = src->bits[w];
+
+    dst->bits[w] = cur
+      // East and west
+      | (cur << 1) | (prev >> 63)
+      | (cur >> 1) | (next << 63)
+      // South and north
+      | (cur << rowOffset) | (prev >> (64-rowOffset))
+      | (cur >> rowOffset) | (next << (64-rowOffset));
+  }
+}
+
+void Bitboard_fill(Bitboard* region, const Bitboard* mask, int rowOffset)
+{
+  Bitboard grown;
+  int changed = 1;
+
+  while( changed ){
+    Bitboard_dilate(&grown, region, rowOffset);
+
+    // Keep only what can be reached, and stop when nothing new is
+    changed = 0;
+    for( int w=0; w<BITBOARD_WORDS; w++ ){
+      unsigned long long bits = region->bits[w] | (grown.bits[w] & mask->bits[w]);
+      changed |= bits != region->bits[w];
+      region->bits[w] = bits;
+    }
+  }
+}
+
+int Bitboard_count(const Bitboard* bb)
+{
+  int count = 0;
+  for( int w=0; w<BITBOARD_WORDS; w++ ){
+    count += __builtin_popcountll(bb->bits[w]);
+  }
+  return count;
+}
+
+int Bitboard_list(const Bitboard* bb, INTERSECTION* out, int k)
+{
+  int n = 0;
+  for( int w=0; w<BITBOARD_WORDS && n<k; w++ ){
+    unsigned long long bits = bb->bits[w];
+    while( bits && n<k ){
+      out[n++] = w*64 + __builtin_ctzll(bits);
+      bits &= bits-1;
+    }
+  }
+  return n;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file  bitboard.h
+ * @brief Provides a bitmask representation of a set of intersections.
+ *
+ * Every intersection index of a board (border included) maps to one bit,
+ * so that whole regions can be grown or intersected a word at a time.
+ *
+ **/
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "global_defs.h"
+
+/**
+ * @brief Number of 64-bit words needed to map all intersections
+ **/
+#define BITBOARD_WORDS ((MAX_INTERSECTION_NUM + 63) / 64)
+
+/**
+ * @brief A set of intersections, one bit each
+ **/
+typedef struct Bitboard
+{
+  unsigned long long bits[BITBOARD_WORDS];
+
+} Bitboard;
+
+/**
+ * @brief Utilities to set, clear and test a single intersection
+ **/
+#define BITBOARD_SET(bb, x) ((bb)->bits[(x)>>6] |= (1ULL << ((x)&63)))
+#define BITBOARD_UNSET(bb, x) ((bb)->bits[(x)>>6] &= ~(1ULL << ((x)&63)))
+#define BITBOARD_TEST(bb, x) (((bb)->bits[(x)>>6] >> ((x)&63)) & 1)
+
+/**
+ * @brief Empties the set
+ *
+ * @param bb The bitboard
+ **/
+void Bitboard_clear(Bitboard* bb);
+
+/**
+ * @brief Grows a set by one step in the four orthogonal directions.
+ * dst receives src along with all the intersections that
+ * are orthogonal neighbours of some intersection of src.
+ * dst and src must not be the same bitboard.
+ *
+ * @param dst The grown set
+ * @param src The set to grow
+ * @param rowOffset Index distance between two vertically adjacent
+ * intersections (board size + 1)
+ **/
+void Bitboard_dilate(Bitboard* dst, const Bitboard* src, int rowOffset);
+
+/**
+ * @brief Grows a set through the intersections of a mask until no more
+ * intersections can be reached (4-connected region fill).
+ *
+ * @param region The seed set, which is filled in place
+ * @param mask The intersections the region is allowed to grow into
+ * @param rowOffset Index distance between two vertically adjacent
+ * intersections (board size + 1)
+ **/
+void Bitboard_fill(Bitboard* region, const Bitboard* mask, int rowOffset);
+
+/**
+ * @brief Counts the intersections in the set
+ *
+ * @param bb The bitboard
+ * @return The number of bits set
+ **/
+int Bitboard_count(const Bitboard* bb);
+
+/**
+ * @brief Lists the first intersections of the set, in index order
+ *
+ * @param bb The bitboard
+ * @param out Array receiving the intersections
+ * @param k Maximum number of intersections to list
+ * @return The number of intersections written to out (at most k)
+ **/
+int Bitboard_list(const Bitboard* bb, INTERSECTION* out, int k);
+
+#endif
@@ -103,6 +103,61 @@ void Board_maybeAtari3x3(Board* board, GRID group);
  **/
 void Board_maybeAtariEnd3x3(Board* board, GRID group);
 
+/**
+ * @brief Fills the alive stones and reachable areas of both colors
+ * for area counting.
+ *
+ * @param board The board
+ * @param dead Dead stones (may be NULL)
+ * @param alive Alive stones bitboards, by color
+ * @param reach Alive stones plus the empty/dead intersections they reach, by color
+ **/
+void Board_areaReach(Board* board, const Bitboard* dead, 
+		     Bitboard alive[2], Bitboard reach[2]);
+
+/**
+ * @brief Ladder reading step where the owner of the group in atari
+ * is to play
+ *
+ * @param board The board
+ * @param stone Any stone of the group
+ * @param lib The only liberty of the group
+ * @param depth Number of moves read so far
+ * @param nodes Number of positions visited so far
+ * @return 1 if the group is captured
+ **/
+int Board_ladderDefend(Board* board, INTERSECTION stone, INTERSECTION lib,
+		       int depth, int* nodes);
+
+/**
+ * @brief Ladder reading step where the opponent of the group with
+ * two liberties is to play
+ *
+ * @param board The board
+ * @param stone Any stone of the group
+ * @param libs The two liberties of the group
+ * @param depth Number of moves read so far
+ * @param nodes Number of positions visited so far
+ * @return 1 if the group is captured
+ **/
+int Board_ladderAttack(Board* board, INTERSECTION stone, INTERSECTION* libs,
+		       int depth, int* nodes);
+
+/**
+ * @brief Ladder reading step where the opponent of the group with
+ * two liberties plays atari on one of them
+ *
+ * @param board The board
+ * @param stone Any stone of the group
+ * @param atari The liberty played by the opponent
+ * @param escape The other liberty
+ * @param depth Number of moves read so far
+ * @param nodes Number of positions visited so far
+ * @return 1 if the group is captured
+ **/
+int Board_ladderAtari(Board* board, INTERSECTION stone, INTERSECTION atari,
+		      INTERSECTION escape, int depth, int* nodes);
+
 void Board_initialize(Board* board, unsigned char size)
 {
   gauAssert(size <= MAX_BOARD_SIZE, board, NULL);
@@ -124,10 +179,15 @@ void Board_initialize(Board* board, unsigned char size)
   // no captures
   board->whiteCaptures = 0;
   board->blackCaptures = 0;
+  board->stonesDiff = 0;
   // black's turn at start
   board->turn = BLACK;
   // no last move
   board->lastMove = 0;
+  board->previousWasCapture = 0;
+  memset(board->newAtari, 0, sizeof(board->newAtari));
+  board->patternHook = NULL;
+  board->patternHookCtx = NULL;
 
   // Clears hash (empty board is (1,1) 
   // to differentiate from unstored position(0,0))
@@ -277,6 +337,8 @@ int Board_isLegal(Board* board, INTERSECTION intersection)
   int capture, not_suicide = 0;
   for( NEIGHBORS(intersection ) ){
     neigh = NEIGHI(board, intersection);
+    // Borders map to the null group, whose liberties mean nothing
+    if( board->intersectionMap[neigh] > WHITE ) continue;
     capture = board->groups[board->groupMap[neigh]].libertiesNum == 0;
     // It is not suicide if you capture an opponent group
     // or it is not atari if any of your groups would not be killed by
@@ -295,12 +357,44 @@ int Board_isLegal(Board* board, INTERSECTION intersection)
 
 int Board_isLegalNoEyeFilling(Board* board, INTERSECTION intersection)
 {
-  // Eye information in 3x3 info bits
-  if( p3x3info[board->patterns3x3[intersection]] & (board->turn+1) ) 
-    return 0;
-  // Must be legal
-  if( !Board_isLegal( board, intersection ) ) return 0;
-  return 1;
+  return board->koPosition != intersection
+    && (Board_playableColors(board, intersection) & (board->turn+1));
+}
+
+int Board_playableColors(Board* board, INTERSECTION intersection)
+{
+  if( board->intersectionMap[intersection] != EMPTY ) return 0;
+
+  // Touching an empty square: legal and not an eye for both colors
+  // (checked before the 3x3 info lookup, which is way more expensive)
+  int neigh;
+  for( NEIGHBORS(intersection) ){
+    neigh = NEIGHI(board, intersection);
+    if( board->intersectionMap[neigh] == EMPTY ) return 3;
+  }
+
+  // Eye information in 3x3 info bits: not playable for the eye's owner
+  int colors = ~p3x3info[board->patterns3x3[intersection]] & 3;
+
+  /* Otherwise legal for a color if:
+     a) It is killing any opponent group (in atari)
+     b) It is touching any friend group not in atari
+  */
+  int legal = 0;
+  for( NEIGHBORS(intersection) ){
+    neigh = NEIGHI(board, intersection);
+    Color neighColor = board->intersectionMap[neigh];
+    if( neighColor > WHITE ) continue;
+
+    if( StoneGroup_isAtari(&board->groups[board->groupMap[neigh]]) ){
+      legal |= (!neighColor)+1;
+    }
+    else{
+      legal |= neighColor+1;
+    }
+  }
+
+  return colors & legal;
 }
 
 int Board_anyEmptyNeigh(Board* board, INTERSECTION intersection)
@@ -308,17 +402,299 @@ int Board_anyEmptyNeigh(Board* board, INTERSECTION intersection)
   return p3x3info[board->patterns3x3[intersection]] >= 3;
 }
 
-int Board_mustPass(Board* board, BoardIterator* iter)
+int Board_mustPass(Board* board)
 {
-  INTERSECTION intersection;
-  for( INTERSECTIONS(iter) ){
-    intersection = INTERSECTIONI(iter);
-    if( Board_isLegal(board, intersection) ) return 0;
+  int empty;
+  for( EMPTIES(board) ){
+    empty = EMPTYI(board);
+    if( Board_isLegalNoEyeFilling(board, empty) ) return 0;
   }
 
   return 1;
 }
 
+INTERSECTION Board_randomPlayable(Board* board, Rng* rng)
+{
+  if( board->emptiesNum == 0 ) return PASS;
+
+  // Most of the time most empty intersections are playable
+  for( int g=0; g<PLAYABLE_GUESSES; g++ ){
+    INTERSECTION empty = board->empties[Rng_range(rng, board->emptiesNum)];
+    if( Board_isLegalNoEyeFilling(board, empty) ) return empty;
+  }
+
+  // Otherwise pick among all the playable ones (still uniform)
+  INTERSECTION playable[MAX_INTERSECTION_NUM];
+  int playableNum = 0;
+  int empty;
+  for( EMPTIES(board) ){
+    empty = EMPTYI(board);
+    if( Board_isLegalNoEyeFilling(board, empty) ){
+      playable[playableNum++] = empty;
+    }
+  }
+
+  if( playableNum == 0 ) return PASS;
+  return playable[Rng_range(rng, playableNum)];
+}
+
+int Board_libertiesNum(Board* board, GRID group)
+{
+#ifdef EXACT_LIBERTIES
+  return Bitboard_count(&board->groups[group].libBits);
+#else
+  INTERSECTION libs[MAX_INTERSECTION_NUM];
+  return Board_scanLiberties(board, group, libs, MAX_INTERSECTION_NUM);
+#endif
+}
+
+int Board_liberties(Board* board, GRID group, INTERSECTION* libs, int k)
+{
+#ifdef EXACT_LIBERTIES
+  return Bitboard_list(&board->groups[group].libBits, libs, k);
+#else
+  return Board_scanLiberties(board, group, libs, k);
+#endif
+}
+
+int Board_scanLiberties(Board* board, GRID group, INTERSECTION* libs, int k)
+{
+  Bitboard found;
+  Bitboard_clear(&found);
+
+  int neigh;
+  for( STONES(board, group) ){
+    INTERSECTION stone = STONEI();
+    for( NEIGHBORS(stone) ){
+      neigh = NEIGHI(board, stone);
+      if( board->intersectionMap[neigh] == EMPTY ){
+	BITBOARD_SET(&found, neigh);
+      }
+    }
+  }
+
+  return Bitboard_list(&found, libs, k);
+}
+
+void Board_quickPlay(Board* board, INTERSECTION intersection, Color color,
+		     BoardUndo* undo)
+{
+  undo->move = intersection;
+  undo->savedNum = 0;
+  undo->mergedNum = 0;
+
+  // Save all groups that are going to change
+  int neigh;
+  undo->savedGroups[undo->savedNum] = intersection;
+  undo->saved[undo->savedNum++] = board->groups[intersection];
+  for( NEIGHBORS(intersection) ){
+    neigh = NEIGHI(board, intersection);
+    if( board->intersectionMap[neigh] > WHITE ) continue;
+    undo->savedGroups[undo->savedNum] = board->groupMap[neigh];
+    undo->saved[undo->savedNum++] = board->groups[board->groupMap[neigh]];
+  }
+
+  // New group with the single stone
+  StoneGroup* group = &board->groups[intersection];
+  group->libertiesNum = 0;
+  group->libSum = 0;
+  group->libSumSq = 0;
+  group->stonesNum = 1;
+  group->groupHead = intersection;
+#ifdef EXACT_LIBERTIES
+  Bitboard_clear(&group->libBits);
+#endif
+  board->intersectionMap[intersection] = color;
+  board->groupMap[intersection] = intersection;
+  board->nextStone[intersection] = 0;
+
+  for( NEIGHBORS(intersection) ){
+    neigh = NEIGHI(board, intersection);
+    if( board->intersectionMap[neigh] == EMPTY ){
+      StoneGroup_addLib(group, neigh);
+    }
+    else if( board->intersectionMap[neigh] <= WHITE ){
+      StoneGroup_subLib(&board->groups[board->groupMap[neigh]], intersection);
+    }
+  }
+
+  // Merge friend groups, the same way Board_play does
+  GRID unifiedGroup = intersection;
+  for( NEIGHBORS(intersection) ){
+    neigh = NEIGHI(board, intersection);
+    GRID neighgroup = board->groupMap[neigh];
+    if( board->intersectionMap[neigh] != color 
+	|| neighgroup == unifiedGroup ) continue;
+
+    GRID newGroup = neighgroup, oldGroup = unifiedGroup;
+    if( board->groups[unifiedGroup].stonesNum
+	> board->groups[neighgroup].stonesNum ){
+      newGroup = unifiedGroup;
+      oldGroup = neighgroup;
+    }
+
+    undo->mergedGroup[undo->mergedNum] = oldGroup;
+    undo->mergedHead[undo->mergedNum] = board->groups[oldGroup].groupHead;
+    undo->mergedNext[undo->mergedNum++] = 
+      board->nextStone[board->groups[newGroup].groupHead];
+    Board_mergeGroups(board, newGroup, oldGroup);
+    unifiedGroup = newGroup;
+  }
+}
+
+void Board_undoQuickPlay(Board* board, BoardUndo* undo)
+{
+  // Split merged groups, last merge first
+  for( int m=undo->mergedNum-1; m>=0; m-- ){
+    GRID oldGroup = undo->mergedGroup[m];
+    INTERSECTION next = undo->mergedNext[m];
+    INTERSECTION head = board->groups[board->groupMap[undo->mergedHead[m]]].groupHead;
+
+    // The absorbed stones were inserted right after the head
+    INTERSECTION stone = undo->mergedHead[m];
+    while( 1 ){
+      board->groupMap[stone] = oldGroup;
+      if( board->nextStone[stone] == next ) break;
+      stone = board->nextStone[stone];
+    }
+    board->nextStone[stone] = 0;
+    board->nextStone[head] = next;
+  }
+
+  // Restore groups, first saved last (saves may be repeated)
+  for( int g=undo->savedNum-1; g>=0; g-- ){
+    board->groups[undo->savedGroups[g]] = undo->saved[g];
+  }
+
+  board->intersectionMap[undo->move] = EMPTY;
+  board->groupMap[undo->move] = NULL_GROUP;
+}
+
+int Board_ladderCapturable(Board* board, GRID group)
+{
+  INTERSECTION stone = board->groups[group].groupHead;
+  Color color = board->intersectionMap[stone];
+  INTERSECTION libs[3];
+  int nodes = 0;
+
+  switch( Board_liberties(board, group, libs, 3) ){
+  case 1:{
+    // Quick escapes from the 3x3 pattern of the liberty
+    int pattern = board->patterns3x3[libs[0]];
+    if( (p3x3info[pattern] >> 2) >= 3 ) return 0;
+    for( int k=0; k<4; k++ ){
+      int dir = nodiags[k];
+      int atari = (pattern >> (19-k)) & 1;
+      int neighColor = (pattern >> ((7-dir)*2)) & 3;
+      // Extending captures an opponent group
+      if( atari && neighColor == (2|!color) ) return 0;
+    }
+    return Board_ladderDefend(board, stone, libs[0], 0, &nodes);
+  }
+  case 2:
+    return Board_ladderAttack(board, stone, libs, 0, &nodes);
+  default:
+    return 0;
+  }
+}
+
+int Board_ladderAtariCaptures(Board* board, GRID group, INTERSECTION atari)
+{
+  INTERSECTION libs[3];
+  int nodes = 0;
+
+  if( Board_liberties(board, group, libs, 3) != 2 ) return 0;
+  if( atari != libs[0] && atari != libs[1] ) return 0;
+
+  INTERSECTION stone = board->groups[group].groupHead;
+  INTERSECTION escape = atari == libs[0] ? libs[1] : libs[0];
+  return Board_ladderAtari(board, stone, atari, escape, 0, &nodes);
+}
+
+int Board_ladderDefend(Board* board, INTERSECTION stone, INTERSECTION lib,
+		       int depth, int* nodes)
+{
+  if( depth >= LADDER_DEPTH_MAX || ++(*nodes) > LADDER_NODES_MAX ) return 0;
+
+  Color color = board->intersectionMap[stone];
+  GRID group = board->groupMap[stone];
+
+  // Capturing an opponent group in atari gives liberties: escaped
+  int neigh;
+  for( STONES(board, group) ){
+    INTERSECTION st = STONEI();
+    for( NEIGHBORS(st) ){
+      neigh = NEIGHI(board, st);
+      if( board->intersectionMap[neigh] == !color
+	  && StoneGroup_isAtari(&board->groups[board->groupMap[neigh]]) ){
+	return 0;
+      }
+    }
+  }
+
+  // Extend
+  BoardUndo undo;
+  Board_quickPlay(board, lib, color, &undo);
+
+  INTERSECTION libs[3];
+  int captured;
+  switch( Board_liberties(board, board->groupMap[stone], libs, 3) ){
+  case 0:
+  case 1: captured = 1; break;
+  case 2: captured = Board_ladderAttack(board, stone, libs, depth+1, nodes); break;
+  default: captured = 0; break;
+  }
+
+  // The extension captured something away from the group: escaped
+  for( NEIGHBORS(lib) ){
+    neigh = NEIGHI(board, lib);
+    if( board->intersectionMap[neigh] == !color
+	&& board->groups[board->groupMap[neigh]].libertiesNum == 0 ){
+      captured = 0;
+    }
+  }
+
+  Board_undoQuickPlay(board, &undo);
+  return captured;
+}
+
+int Board_ladderAttack(Board* board, INTERSECTION stone, INTERSECTION* libs,
+		       int depth, int* nodes)
+{
+  if( depth >= LADDER_DEPTH_MAX || ++(*nodes) > LADDER_NODES_MAX ) return 0;
+
+  return Board_ladderAtari(board, stone, libs[0], libs[1], depth, nodes)
+    || Board_ladderAtari(board, stone, libs[1], libs[0], depth, nodes);
+}
+
+int Board_ladderAtari(Board* board, INTERSECTION stone, INTERSECTION atari,
+		      INTERSECTION escape, int depth, int* nodes)
+{
+  Color color = board->intersectionMap[stone];
+
+  BoardUndo undo;
+  Board_quickPlay(board, atari, !color, &undo);
+
+  // Suicide, or capturing stones (which gives liberties): skip
+  int valid = board->groups[board->groupMap[atari]].libertiesNum > 0;
+  int neigh;
+  for( NEIGHBORS(atari) ){
+    neigh = NEIGHI(board, atari);
+    if( board->intersectionMap[neigh] == color
+	&& board->groups[board->groupMap[neigh]].libertiesNum == 0 ){
+      valid = 0;
+    }
+  }
+
+  int captured = 0;
+  if( valid ){
+    captured = Board_ladderDefend(board, stone, escape, depth+1, nodes);
+  }
+
+  Board_undoQuickPlay(board, &undo);
+  return captured;
+}
+
 void Board_play(Board* board, INTERSECTION intersection)
 {
   gauAssert(Board_isLegal(board, intersection), board, NULL);
@@ -333,6 +709,10 @@ void Board_play(Board* board, INTERSECTION intersection)
   short capturedStones = 0;
   INTERSECTION koPosition = -1;
 
+  // Opponent groups put in atari
+  int newAtariNum = 0;
+  memset(board->newAtari, 0, sizeof(board->newAtari));
+
   // Create a group for the new stone (which will be eventually merged)
   GRID unifiedGroup = Board_placeStone(board, intersection);
 
@@ -368,6 +748,14 @@ void Board_play(Board* board, INTERSECTION intersection)
 	// Might be in atari: update pattern
 	else{
 	  Board_maybeAtari3x3(board, neighgroup);
+	  if( StoneGroup_isAtari(&board->groups[neighgroup]) 
+	      && newAtariNum < 3 ){
+	    int known = 0;
+	    for( int a=0; a<newAtariNum; a++ ){
+	      known |= board->newAtari[a] == neighgroup;
+	    }
+	    if( !known ) board->newAtari[newAtariNum++] = neighgroup;
+	  }
 	}
       }
     }
@@ -389,6 +777,8 @@ void Board_play(Board* board, INTERSECTION intersection)
     }
   }
 
+  board->previousWasCapture = capturedStones > 0;
+
   // You may be in atari
   Board_maybeAtari3x3(board, unifiedGroup);
   
@@ -409,6 +799,8 @@ void Board_maybeAtari3x3(Board* board, GRID group)
     | ((board->groupMap[atari+board->directionOffsets[6]]==group) << 16);
   
   board->patterns3x3[atari] |= atariBits;
+
+  if( board->patternHook ) board->patternHook(board->patternHookCtx, atari);
 }
 
 void Board_maybeAtariEnd3x3(Board* board, GRID group)
@@ -426,6 +818,8 @@ void Board_maybeAtariEnd3x3(Board* board, GRID group)
     | ((board->groupMap[atari+board->directionOffsets[6]]==group) << 16);
   
   board->patterns3x3[atari] &= ~atariBits;
+
+  if( board->patternHook ) board->patternHook(board->patternHookCtx, atari);
 }
 
 HashKey Board_childHash(Board* board, INTERSECTION intersection)
@@ -479,6 +873,9 @@ HashKey Board_childHash(Board* board, INTERSECTION intersection)
 void Board_pass(Board* board)
 {
   board->turn = !board->turn;
+  board->lastMove = PASS;
+  board->previousWasCapture = 0;
+  memset(board->newAtari, 0, sizeof(board->newAtari));
 
   // Not ko anymore
   Board_unsetKoPosition(board);
@@ -491,16 +888,80 @@ int Board_trompTaylorScore(Board* board, BoardIterator* it)
   INTERSECTION intersection;
   for( INTERSECTIONS(it) ){
     intersection = INTERSECTIONI(it);
-    
-    switch( board->intersectionMap[intersection] ){
-    case BLACK: points++; break;
-    case WHITE: points--; break;
-    case EMPTY: 
-      if( board->intersectionMap[intersection-1] == BLACK 
-	  || board->intersectionMap[intersection+1] == BLACK ) points++;
-      else points--;
-      break;
+    points += Board_trompTaylorOwner(board, intersection) == BLACK ? 1 : -1;
+  }
+
+  return points;
+}
+
+Color Board_trompTaylorOwner(Board* board, INTERSECTION intersection)
+{
+  switch( board->intersectionMap[intersection] ){
+  case BLACK: return BLACK;
+  case WHITE: return WHITE;
+  default:
+    if( board->intersectionMap[intersection-1] == BLACK 
+	|| board->intersectionMap[intersection+1] == BLACK ) return BLACK;
+    return WHITE;
+  }
+}
+
+void Board_areaReach(Board* board, const Bitboard* dead, 
+		     Bitboard alive[2], Bitboard reach[2])
+{
+  Bitboard space;
+  Bitboard_clear(&space);
+  Bitboard_clear(&alive[BLACK]);
+  Bitboard_clear(&alive[WHITE]);
+
+  for( int i=0; i<MAX_INTERSECTION_NUM; i++ ){
+    Color color = board->intersectionMap[i];
+    if( color == BORDER ) continue;
+
+    // Dead stones count as empty space
+    if( color == EMPTY || (dead && BITBOARD_TEST(dead, i)) ){
+      BITBOARD_SET(&space, i);
     }
+    else{
+      BITBOARD_SET(&alive[color], i);
+    }
+  }
+
+  // Grow both colors through the space
+  reach[BLACK] = alive[BLACK];
+  reach[WHITE] = alive[WHITE];
+  Bitboard_fill(&reach[BLACK], &space, board->size+1);
+  Bitboard_fill(&reach[WHITE], &space, board->size+1);
+}
+
+void Board_areaOwnership(Board* board, const Bitboard* dead, Color* owner)
+{
+  Bitboard alive[2], reach[2];
+  Board_areaReach(board, dead, alive, reach);
+
+  for( int i=0; i<MAX_INTERSECTION_NUM; i++ ){
+    int black = BITBOARD_TEST(&reach[BLACK], i);
+    int white = BITBOARD_TEST(&reach[WHITE], i);
+
+    if( BITBOARD_TEST(&alive[BLACK], i) || (black && !white) ) owner[i] = BLACK;
+    else if( BITBOARD_TEST(&alive[WHITE], i) || (white && !black) ) owner[i] = WHITE;
+    else owner[i] = EMPTY;
+  }
+}
+
+int Board_areaScore(Board* board, const Bitboard* dead)
+{
+  Bitboard alive[2], reach[2];
+  Board_areaReach(board, dead, alive, reach);
+
+  // Alive stones plus territory reached by one color only
+  int points = 0;
+  for( int w=0; w<BITBOARD_WORDS; w++ ){
+    unsigned long long black = reach[BLACK].bits[w] & ~reach[WHITE].bits[w];
+    unsigned long long white = reach[WHITE].bits[w] & ~reach[BLACK].bits[w];
+    black |= alive[BLACK].bits[w];
+    white |= alive[WHITE].bits[w];
+    points += __builtin_popcountll(black) - __builtin_popcountll(white);
   }
 
   return points;
@@ -525,6 +986,12 @@ void Board_mergeGroups(Board* board, GRID newGroup, GRID oldGroup)
   board->groups[newGroup].libSum += board->groups[oldGroup].libSum;
   board->groups[newGroup].libSumSq += board->groups[oldGroup].libSumSq;
   board->groups[oldGroup].stonesNum = 0;
+#ifdef EXACT_LIBERTIES
+  for( int w=0; w<BITBOARD_WORDS; w++ ){
+    board->groups[newGroup].libBits.bits[w] |= 
+      board->groups[oldGroup].libBits.bits[w];
+  }
+#endif
 
   // Update all stone's map and count liberties
   INTERSECTION mergeHead = board->groups[oldGroup].groupHead;
@@ -577,6 +1044,9 @@ GRID Board_placeStone(Board* board, INTERSECTION intersection)
   board->groups[newGroup].libSumSq = 0;
   board->groups[newGroup].stonesNum = 1;
   board->groups[newGroup].groupHead = intersection;
+#ifdef EXACT_LIBERTIES
+  Bitboard_clear(&board->groups[newGroup].libBits);
+#endif
 
   // Put the stone on the board
   Board_setStone(board, intersection, board->turn);
@@ -621,10 +1091,12 @@ void Board_setStone(Board* board, INTERSECTION intersection, Color color)
   switch( color ){
   case BLACK:
     board->hashKey ^= zobrist1.black[intersection];
+    board->stonesDiff++;
     break;
 
   case WHITE:
     board->hashKey ^= zobrist1.white[intersection];
+    board->stonesDiff--;
     break;
   }
 
@@ -642,6 +1114,14 @@ void Board_setStone(Board* board, INTERSECTION intersection, Color color)
     board->patterns3x3[neigh] = 
       (board->patterns3x3[neigh]&~mask) | (bits & mask);
   }
+
+  if( board->patternHook ){
+    board->patternHook(board->patternHookCtx, intersection);
+    for( NEIGHBORS_DIAG(intersection) ){
+      board->patternHook(board->patternHookCtx, 
+			 NEIGHI_DIAG(board, intersection));
+    }
+  }
 }
 
 void Board_unsetStone(Board* board, INTERSECTION intersection)
@@ -649,16 +1129,21 @@ void Board_unsetStone(Board* board, INTERSECTION intersection)
   switch( board->intersectionMap[intersection] ){
   case BLACK:
     board->hashKey ^= zobrist1.black[intersection];
+    board->stonesDiff--;
     break;
 
   case WHITE:
     board->hashKey ^= zobrist1.white[intersection];
+    board->stonesDiff++;
     break;
   }
 
   board->intersectionMap[intersection] = EMPTY;
   board->groupMap[intersection] = NULL_GROUP;
 
+  // Atari bits are left over from when this was a liberty
+  board->patterns3x3[intersection] &= 0xFFFF;
+
   // Add new empty intersection to list
   board->emptiesMap[intersection] = board->emptiesNum;
   board->empties[board->emptiesNum++] = intersection;
@@ -670,6 +1155,14 @@ void Board_unsetStone(Board* board, INTERSECTION intersection)
     int mask = 3<<(i*2);
     board->patterns3x3[neigh] = board->patterns3x3[neigh]&~mask;
   }
+
+  if( board->patternHook ){
+    board->patternHook(board->patternHookCtx, intersection);
+    for( NEIGHBORS_DIAG(intersection) ){
+      board->patternHook(board->patternHookCtx, 
+			 NEIGHI_DIAG(board, intersection));
+    }
+  }
 }
 
 void Board_print(Board* board, FILE* stream, int withGroupInfo)
@@ -14,6 +14,8 @@
 #include "global_defs.h"
 #include "stonegroup.h"
 #include "hashTable.h"
+#include "bitboard.h"
+#include "rng.h"
 
 #include <stdio.h>
 
@@ -27,6 +29,22 @@
  **/
 #define PASS 888
 
+/**
+ * @brief Number of uniform guesses among the empty intersections
+ * tried by Board_randomPlayable before listing the playable ones
+ **/
+#define PLAYABLE_GUESSES 16
+
+/**
+ * @brief Max number of moves read out by the ladder reader
+ **/
+#define LADDER_DEPTH_MAX 160
+
+/**
+ * @brief Max number of positions visited by one ladder reading
+ **/
+#define LADDER_NODES_MAX 400
+
 /**
  * @brief The value that an intersection might have
  **/
@@ -98,6 +116,11 @@ typedef struct Board
    **/
   short emptiesNum;
 
+  /**
+   * Number of black stones minus number of white stones
+   **/
+  short stonesDiff;
+
   /**
    * Current turn to play
    **/
@@ -119,10 +142,21 @@ typedef struct Board
   INTERSECTION koPosition;
 
   /**
-   * Last move played
+   * Last move played (0 at the beginning, PASS after a pass)
    **/
   INTERSECTION lastMove;
 
+  /**
+   * Whether the last move captured stones
+   **/
+  char previousWasCapture;
+
+  /**
+   * Groups of current turn's player put in atari by the last move
+   * (NULL_GROUP for unused entries)
+   **/
+  GRID newAtari[3];
+
   /**
    * Points to the next stone in the group
    * (to fastly loop all stones in a group)
@@ -152,8 +186,46 @@ typedef struct Board
    **/
   signed char directionOffsets[8];
 
+  /**
+   * Called with patternHookCtx and the intersection every time the
+   * 3x3 pattern (atari bits included) of an intersection changes,
+   * or a stone is placed or removed (NULL for none).  Lets playout
+   * policies keep move weights up to date incrementally.
+   **/
+  void (*patternHook)(void* ctx, INTERSECTION intersection);
+  void* patternHookCtx;
+
 } Board;
 
+/**
+ * @brief Information needed to take back a move played with
+ * Board_quickPlay
+ **/
+typedef struct BoardUndo
+{
+  /**
+   * The move to take back
+   **/
+  INTERSECTION move;
+
+  /**
+   * The groups touched by the move, with their state before the move
+   **/
+  GRID savedGroups[5];
+  StoneGroup saved[5];
+  int savedNum;
+
+  /**
+   * For every merge: the absorbed group, its head stone and the
+   * stone that followed the absorbing group's head
+   **/
+  GRID mergedGroup[4];
+  INTERSECTION mergedHead[4];
+  INTERSECTION mergedNext[4];
+  int mergedNum;
+
+} BoardUndo;
+
 /**
  * @brief Utility to loop over all intersections of a board
  * 
@@ -273,13 +345,23 @@ int Board_isLegal(Board* board, INTERSECTION intersection);
 /**
  * @brief Determines if the specified move is legal and not
  * self-eye filling.  It is ok to fill self false eyes if at
- * least two of the diagonals are occupied by opponent's stones
+ * least two of the diagonals are occupied by opponent's stones.
  *
  * @param board The board
  * @param intersection The intersection to play on
  **/
 int Board_isLegalNoEyeFilling(Board* board, INTERSECTION intersection);
 
+/**
+ * @brief Determines for which colors the specified intersection is
+ * legal and not self-eye filling (ko is not checked)
+ *
+ * @param board The board
+ * @param intersection The intersection
+ * @return Bit mask of playable colors (color+1)
+ **/
+int Board_playableColors(Board* board, INTERSECTION intersection);
+
 /**
  * @brief Determines if there is at least one empty intersection
  * neighboring the given one
@@ -290,14 +372,109 @@ int Board_anyEmptyNeigh(Board* board, INTERSECTION intersection);
 
 /**
  * @brief Determines wether the next move for current turn's player 
- * must be a pass or not.
- * This function is SLOW, and not meant for performance
+ * must be a pass or not, i.e. if there are no legal moves other
+ * than self-eye filling ones.
  *
  * @param board The board
- * @param iter A board iterator
- * @return 1 if there are no legal moves on the board, 0 otherwise
+ * @return 1 if there are no playable moves on the board, 0 otherwise
  **/
-int Board_mustPass(Board* board, BoardIterator* iter);
+int Board_mustPass(Board* board);
+
+/**
+ * @brief Picks a playable move for current turn's player uniformly 
+ * at random: empty intersections are guessed at random until one is
+ * playable, and only after PLAYABLE_GUESSES failures are all the 
+ * playable ones listed to pick from.
+ *
+ * @param board The board
+ * @param rng The random number generator
+ * @return A legal and not self-eye filling intersection, or PASS if
+ * there is none
+ **/
+INTERSECTION Board_randomPlayable(Board* board, Rng* rng);
+
+/**
+ * @brief Counts the real liberties of a group (each liberty
+ * once, unlike the group's libertiesNum)
+ *
+ * @param board The board
+ * @param group The group (must not be the null group)
+ * @return The number of distinct liberties
+ **/
+int Board_libertiesNum(Board* board, GRID group);
+
+/**
+ * @brief Lists the first liberties of a group, in intersection order.
+ * Uses the exact liberty sets if EXACT_LIBERTIES is defined,
+ * Board_scanLiberties otherwise.
+ *
+ * @param board The board
+ * @param group The group (must not be the null group)
+ * @param libs Array receiving the liberties
+ * @param k Maximum number of liberties to list
+ * @return The number of liberties written to libs (at most k)
+ **/
+int Board_liberties(Board* board, GRID group, INTERSECTION* libs, int k);
+
+/**
+ * @brief Same as Board_liberties, but always browses the stones
+ * of the group instead of using the exact liberty sets
+ **/
+int Board_scanLiberties(Board* board, GRID group, INTERSECTION* libs, int k);
+
+/**
+ * @brief Places a stone for reading purposes, updating only stones,
+ * groups and liberties (no captures, patterns, hash, empties list,
+ * turn or ko).  Opponent groups left without liberties stay on the
+ * board, and so does the new stone if it has none.
+ * The move must be taken back with Board_undoQuickPlay before
+ * the board is used for anything else.
+ *
+ * @param board The board
+ * @param intersection An empty intersection
+ * @param color The color of the stone
+ * @param undo Receives the information to take back the move
+ **/
+void Board_quickPlay(Board* board, INTERSECTION intersection, Color color,
+		     BoardUndo* undo);
+
+/**
+ * @brief Takes back a move played with Board_quickPlay.
+ * Moves must be taken back in reverse order.
+ *
+ * @param board The board
+ * @param undo The information filled by Board_quickPlay
+ **/
+void Board_undoQuickPlay(Board* board, BoardUndo* undo);
+
+/**
+ * @brief Reads out whether a group can be captured in a ladder.
+ * If the group is in atari, its owner is to play and tries to escape
+ * by extending or capturing a neighbor group in atari.  If it has
+ * two liberties, the opponent is to play and tries both.
+ * Ko and positions deeper than LADDER_DEPTH_MAX moves or bigger
+ * than LADDER_NODES_MAX are read as escaped.
+ * The board is left unchanged.
+ *
+ * @param board The board
+ * @param group The group to read
+ * @return 1 if the group is captured, 0 otherwise (also for groups
+ * with more than two liberties)
+ **/
+int Board_ladderCapturable(Board* board, GRID group);
+
+/**
+ * @brief Reads out whether an atari on a group with two liberties
+ * starts a ladder that captures it (see Board_ladderCapturable).
+ * The board is left unchanged.
+ *
+ * @param board The board
+ * @param group The group to read
+ * @param atari One of the two liberties of the group
+ * @return 1 if the group is captured, 0 otherwise (also if atari is
+ * not one of its two liberties)
+ **/
+int Board_ladderAtariCaptures(Board* board, GRID group, INTERSECTION atari);
 
 /**
  * @brief Plays at the specified intersection of the board.
@@ -338,6 +515,41 @@ void Board_pass(Board* board);
  **/
 int Board_trompTaylorScore(Board* board, BoardIterator* iterator);
 
+/**
+ * @brief Returns the owner of an intersection of a tromp-taylor finished
+ * game (see Board_trompTaylorScore): the stone's color, or for an empty
+ * intersection the color of its surrounding stones.
+ *
+ * @param board The board (game must be finished)
+ * @param intersection The intersection (not a border)
+ * @return BLACK or WHITE
+ **/
+Color Board_trompTaylorOwner(Board* board, INTERSECTION intersection);
+
+/**
+ * @brief Computes the owner of every intersection by area counting.
+ * Empty regions (and dead stones) are filled from the alive stones of
+ * both colors: a region that is reached by one color only is that color's
+ * territory, while regions reached by both colors or by none are neutral.
+ * Unlike Board_trompTaylorScore, the game does not need to be finished.
+ *
+ * @param board The board
+ * @param dead The stones to be considered dead, or NULL if all stones are alive
+ * @param owner Map to which the owner of every intersection will be written
+ * (BLACK, WHITE, or EMPTY for neutral and border intersections)
+ **/
+void Board_areaOwnership(Board* board, const Bitboard* dead, Color* owner);
+
+/**
+ * @brief Returns the area score of the board, removing the specified dead
+ * stones first (see Board_areaOwnership).
+ *
+ * @param board The board
+ * @param dead The stones to be considered dead, or NULL if all stones are alive
+ * @return The score difference (without komi) from black's point of view
+ **/
+int Board_areaScore(Board* board, const Bitboard* dead);
+
 /**
  * @brief Initializes a board iterator to be used over the current board.
  *
@@ -5,6 +5,7 @@
  **/
 
 #include "board_zobrist.h"
+#include "rng.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -17,25 +18,14 @@
 void ZobristValues_initialize(ZobristValues* zobristValues, unsigned int seed)
 {
   // Sets the seed
-  srand(seed);
+  Rng rng;
+  Rng_seed(&rng, seed);
 
   for( int i=0; i<MAX_INTERSECTION_NUM; i++ ){
-    zobristValues->black[i] = (unsigned long long)(rand() & 0xFF) | ((unsigned long long)(rand() & 0xFF) << 8) 
-      |  ((unsigned long long)(rand() & 0xFF) << 16) |  ((unsigned long long)(rand() & 0xFF) << 24)
-      | ((unsigned long long)(rand() & 0xFF) << 32) | ((unsigned long long)(rand() & 0xFF) << 40) 
-      | ((unsigned long long)(rand() & 0xFF) << 48) |  ((unsigned long long)(rand() & 0xFF) << 56);
-    zobristValues->white[i] = (unsigned long long)(rand() & 0xFF) | ((unsigned long long)(rand() & 0xFF) << 8) 
-      |  ((unsigned long long)(rand() & 0xFF) << 16) |  ((unsigned long long)(rand() & 0xFF) << 24)
-      | ((unsigned long long)(rand() & 0xFF) << 32) | ((unsigned long long)(rand() & 0xFF) << 40) 
-      | ((unsigned long long)(rand() & 0xFF) << 48) |  ((unsigned long long)(rand() & 0xFF) << 56);
-    zobristValues->ko[i] = (unsigned long long)(rand() & 0xFF) | ((unsigned long long)(rand() & 0xFF) << 8) 
-      |  ((unsigned long long)(rand() & 0xFF) << 16) |  ((unsigned long long)(rand() & 0xFF) << 24)
-      | ((unsigned long long)(rand() & 0xFF) << 32) | ((unsigned long long)(rand() & 0xFF) << 40) 
-      | ((unsigned long long)(rand() & 0xFF) << 48) |  ((unsigned long long)(rand() & 0xFF) << 56);
+    zobristValues->black[i] = Rng_next(&rng);
+    zobristValues->white[i] = Rng_next(&rng);
+    zobristValues->ko[i] = Rng_next(&rng);
   }
 
-  zobristValues->turn = (unsigned long long)(rand() & 0xFF) | ((unsigned long long)(rand() & 0xFF) << 8) 
-      |  ((unsigned long long)(rand() & 0xFF) << 16) |  ((unsigned long long)(rand() & 0xFF) << 24)
-      | ((unsigned long long)(rand() & 0xFF) << 32) | ((unsigned long long)(rand() & 0xFF) << 40) 
-      | ((unsigned long long)(rand() & 0xFF) << 48) |  ((unsigned long long)(rand() & 0xFF) << 56);
+  zobristValues->turn = Rng_next(&rng);
 }
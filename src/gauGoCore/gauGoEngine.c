@@ -13,6 +13,10 @@
 #include "GTPGogui.h"
 #include "GTPPatterns.h"
 #include "GTPBench.h"
+#include "GTPTime.h"
+#include "policies.h"
+#include "stoppers.h"
+#include "crash.h"
 
 /**
  * @brief GTP command processor function type
@@ -34,10 +38,13 @@ CmdAndProcessor commandProcessors[] = {
   // Basic
   { "list_commands", &GTPBasicCommands_listCommands },
   { "play", &GTPBasicCommands_play },
+  { "play_sequence", &GTPBasicCommands_playSequence },
   { "genmove", &GTPBasicCommands_genmove },
+  { "analyze", &GTPBasicCommands_analyze },
   { "undo", &GTPBasicCommands_undo },
   { "redo", &GTPBasicCommands_redo },
   { "quit", &GTPBasicCommands_quit },
+  { "stop", &GTPBasicCommands_stop },
   { "komi", &GTPBasicCommands_komi },
   { "showboard", &GTPBasicCommands_printboard },
   { "boardsize", &GTPBasicCommands_boardsize },
@@ -46,40 +53,217 @@ CmdAndProcessor commandProcessors[] = {
   { "protocol_version", &GTPBasicCommands_protocolversion },
   { "version", &GTPBasicCommands_version },
   { "final_score", &GTPBasicCommands_finalscore },
+  { "final_status_list", &GTPBasicCommands_finalstatuslist },
+
+  // Time control
+  { "time_settings", &GTPTime_timeSettings },
+  { "kgs-time_settings", &GTPTime_kgsTimeSettings },
+  { "time_left", &GTPTime_timeLeft },
 
   // Archiving
   { "load", &GTPArchiving_loadSGF },
+  { "loadsgf", &GTPArchiving_loadSGF },
   { "save", &GTPArchiving_saveSGF },
 
   // Gogui
   { "gogui-analyze_commands", &GTPGogui_analyzecommands },
   { "gogui-nodeinfo", &GTPGogui_nodeinfo },
   { "gogui-pv", &GTPGogui_pv },
+  { "gogui-ownership", &GTPGogui_ownership },
+  { "gogui-criticality", &GTPGogui_criticality },
 
   // Patterns
   { "pattern", &GTPPatterns_pattern },
   { "pinfo", &GTPPatterns_patternInfo },
+  { "ladder", &GTPPatterns_ladder },
 
   // Bench
   { "pobench", &GTPBench_playoutBench },
+  { "libbench", &GTPBench_libertiesBench },
+  { "ladderbench", &GTPBench_ladderBench },
+  { "gtpbench", &GTPBench_gtpBench },
 
   { NULL, NULL }
 };
 
+/**
+ * @brief Commands sorted by name, for binary search
+ **/
+#define COMMANDS_MAX (sizeof(commandProcessors) / sizeof(*commandProcessors))
+CmdAndProcessor* commandIndex[COMMANDS_MAX];
+int commandsNum = 0;
+
+/**
+ * @brief Orders commands by name, or finds a command by name 
+ * (with the name as first argument)
+ **/
+int gauGoEngine_commandCmp( const void* a, const void* b )
+{
+  return strcmp( (*(CmdAndProcessor**)a)->commandName, 
+		 (*(CmdAndProcessor**)b)->commandName );
+}
+
+int gauGoEngine_commandNameCmp( const void* name, const void* command )
+{
+  return strcmp( (const char*)name, (*(CmdAndProcessor**)command)->commandName );
+}
+
 
 int GauGoEngine_initialize( GauGoEngine* engine, int argc, char** argv )
 {
-  // Parses command-line options
-  Options_initialize( &engine->options, argc, argv );
+  Options options;
+  Options_initialize( &options, argc, argv );
+  if( !GauGoEngine_initializeShared( &options ) ) return 0;
+  if( !GauGoEngine_initializeWithOptions( engine, &options ) ){
+    fprintf(stderr, "Cannot set up the playout policy\n");
+    return 0;
+  }
+
+  // Randomize (reproducible if a seed is given)
+  Rng_seed( &threadRng, options.seed ? options.seed : (unsigned long long)time(NULL) );
+
+  return 1;
+}
+
+int GauGoEngine_initializeShared( Options* options )
+{
+  // Command index
+  if( commandsNum == 0 ){
+    CmdAndProcessor* it;
+    for( it = commandProcessors; it->commandName; it++ ){
+      commandIndex[commandsNum++] = it;
+    }
+    qsort( commandIndex, commandsNum, sizeof(*commandIndex), 
+	   &gauGoEngine_commandCmp );
+  }
+
+  // Pattern weights
+  if( options->patternWeightsFile
+      && !POLICY_patterns3x3LoadWeights( options->patternWeightsFile ) ){
+    fprintf(stderr, "Cannot open pattern weights file %s\n", 
+	    options->patternWeightsFile);
+    return 0;
+  }
+
+  // Zobrist values
+  Board board;
+  Board_initialize( &board, options->boardSize );
+
+  // Playout patterns (the mogo ones are also used by the priors)
+  Policy policy;
+  Policy_initialize( &policy, POLICY_ID_MOGO );
+  Policy_teardown( &policy );
+  if( !Policy_initialize( &policy, options->policy ) ){
+    fprintf(stderr, "Cannot set up the playout policy\n");
+    return 0;
+  }
+  Policy_teardown( &policy );
+
+  // Cycle counter frequency, read by the search deadlines
+  CycleTimer_calibrate();
+
+  return 1;
+}
+
+int GauGoEngine_initializeWithOptions( GauGoEngine* engine, Options* options )
+{
+  // GTP responses
+  engine->out = stdout;
+  engine->gtpId = -1;
+  engine->stopRequested = 0;
+  engine->quitRequested = 0;
+  engine->releaseTree = 0;
+
+  engine->options = *options;
+  // No time limit until the controller gives one
+  TimeControl_initialize( &engine->timeControl );
   // Set empty tree
   UCTTree_initializeEmpty(&engine->lastTree);
   // Init board
   GauGoEngine_resetBoard( engine );
 
-  // Randomize
-  srand( time(NULL) );
+  return Policy_initialize( &engine->policy, engine->options.policy );
+}
 
-  return 1;
+void GauGoEngine_delete( GauGoEngine* engine )
+{
+  UCTTree_delete( &engine->lastTree );
+  UCTTree_initializeEmpty( &engine->lastTree );
+  Policy_teardown( &engine->policy );
+}
+
+Policy* GauGoEngine_policy( GauGoEngine* engine )
+{
+  // The board size might have changed
+  engine->policy.mercyThreshold = 
+    Options_mercyThreshold( &engine->options, engine->board->size );
+  return &engine->policy;
+}
+
+void GauGoEngine_initializeSearch( GauGoEngine* engine, UCTSearch* search,
+				   STOPPER stopper )
+{
+  // Initializes new empty tree
+  UCTTree_delete( &engine->lastTree );
+  UCTTree_initialize( 
+		     &engine->lastTree, 
+		     engine->options.treePoolNodeNum,
+		     engine->board);
+
+  // Game positions' hash keys
+  UCTSearch_initialize( search, engine->board, 
+			&engine->lastTree, GauGoEngine_policy( engine ), 
+			stopper, &engine->options, 
+			engine->historyHashes, engine->currentHistoryPos+1 );
+  search->interrupt = &engine->stopRequested;
+  search->out = engine->out;
+}
+
+void GauGoEngine_searchDone( GauGoEngine* engine, UCTSearch* search )
+{
+  // Keep ownership and criticality for analysis commands
+  engine->lastStats = search->stats;
+  engine->lastStatsHash = engine->board->hashKey;
+
+  if( engine->releaseTree ){
+    UCTTree_delete( &engine->lastTree );
+    UCTTree_initializeEmpty( &engine->lastTree );
+  }
+}
+
+INTERSECTION GauGoEngine_genmove( GauGoEngine* engine, int* playouts,
+				  int* elapsed )
+{
+  if( playouts ) *playouts = 0;
+  if( elapsed ) *elapsed = 0;
+
+  // If no legal moves to play, play pass without thinking
+  if( Board_mustPass( engine->board ) ){
+    GauGoEngine_play(engine, PASS);
+    return PASS;
+  }
+
+  // Time for the move, or a fixed number of simulations
+  // without time limit
+  Color turn = engine->board->turn;
+  int maxTime = TimeControl_moveTime( &engine->timeControl, engine->board );
+
+  // UCT search
+  UCTSearch search;
+  GauGoEngine_initializeSearch( engine, &search, 
+				maxTime ? &STOPPER_time : &STOPPER_5ksim );
+  search.maxTime = maxTime;
+  INTERSECTION move = UCTSearch_search( &search );
+  int searchTime = Timer_getElapsedTime( &search.timer );
+  TimeControl_moveDone( &engine->timeControl, turn, searchTime );
+  GauGoEngine_searchDone( engine, &search );
+  if( playouts ) *playouts = search.stats.playouts;
+  if( elapsed ) *elapsed = searchTime;
+
+  gauAssert( move == PASS || Board_isLegal( engine->board, move ), 
+	     engine->board, NULL );
+  GauGoEngine_play(engine, move);
+  return move;
 }
 
 void GauGoEngine_resetBoard( GauGoEngine* engine )
@@ -87,14 +271,17 @@ void GauGoEngine_resetBoard( GauGoEngine* engine )
   // Empty history
   engine->historyLength = 1;
   engine->currentHistoryPos = 0;
-  engine->board = &engine->history[0];
+  engine->board = &engine->position;
 
   // Initializes the board
   Board_initialize( engine->board, engine->options.boardSize );
+  engine->historyHashes[0] = engine->board->hashKey;
 
   // Init tree to empty
   UCTTree_delete(&engine->lastTree);
   UCTTree_initializeEmpty(&engine->lastTree);
+  PlayoutStats_clear(&engine->lastStats);
+  engine->lastStatsHash = 0;
 }
 
 UCTNode* GauGoEngine_getTreePos( GauGoEngine* engine )
@@ -109,7 +296,7 @@ UCTNode* GauGoEngine_getTreePos( GauGoEngine* engine )
   for( i=0; i<engine->currentHistoryPos+1; i++ ){
     
     // Remember root when found
-    if( engine->history[i].hashKey == engine->lastTree.rootHash ) {
+    if( engine->historyHashes[i] == engine->lastTree.rootHash ) {
       rootFound = 1;
     }
 
@@ -130,9 +317,23 @@ UCTNode* GauGoEngine_getTreePos( GauGoEngine* engine )
   return position;
 }
 
+/**
+ * @brief Plays a move on the engine's board, and records the hash key
+ * of the new position (the move must be already in the history)
+ *
+ * @param engine The engine
+ **/
+void gauGoEngine_playHistoryMove(GauGoEngine* engine)
+{
+  INTERSECTION move = engine->historyMoves[ engine->currentHistoryPos++ ];
+  if( move == PASS ) Board_pass( engine->board );
+  else Board_play( engine->board, move );
+  engine->historyHashes[ engine->currentHistoryPos ] = engine->board->hashKey;
+}
+
 void GauGoEngine_play(GauGoEngine* engine, INTERSECTION move)
 {
-  assert( engine->historyLength <= HISTORY_LENGTH_MAX );
+  assert( engine->currentHistoryPos < HISTORY_LENGTH_MAX-1 );
 
   // If the redo is possible
   int redone = 0;
@@ -151,14 +352,20 @@ void GauGoEngine_play(GauGoEngine* engine, INTERSECTION move)
   }
 
   if( !redone ){
-    // Copy current position
-    engine->history[ engine->historyLength++ ] = *engine->board;
-    engine->historyMoves[ engine->currentHistoryPos++ ] = move;
-    engine->board = &engine->history[ engine->currentHistoryPos ];
-    
-    // Play the move
-    if( move == PASS ) Board_pass( engine->board );
-    else Board_play( engine->board, move );
+    // Record and play the move
+    engine->historyMoves[ engine->currentHistoryPos ] = move;
+    gauGoEngine_playHistoryMove( engine );
+    engine->historyLength = engine->currentHistoryPos+1;
+  }
+}
+
+void GauGoEngine_rewind(GauGoEngine* engine, int historyPos)
+{
+  // Replay the game from the empty board
+  Board_initialize( engine->board, engine->board->size );
+  engine->currentHistoryPos = 0;
+  while( engine->currentHistoryPos < historyPos ){
+    gauGoEngine_playHistoryMove( engine );
   }
 }
 
@@ -167,7 +374,7 @@ int GauGoEngine_undo(GauGoEngine* engine)
   if( engine->currentHistoryPos == 0 ) return 0;
 
   // Undo board
-  engine->board = &engine->history[--engine->currentHistoryPos];
+  GauGoEngine_rewind( engine, engine->currentHistoryPos-1 );
 
   return 1;
 }
@@ -176,7 +383,7 @@ int GauGoEngine_redo(GauGoEngine* engine)
 {
   // Redo board
   if( engine->currentHistoryPos < engine->historyLength-1 ) {
-    engine->board = &engine->history[++engine->currentHistoryPos];
+    gauGoEngine_playHistoryMove( engine );
     return 1;
   }
 
@@ -187,57 +394,112 @@ void GauGoEngine_receiveGTPCommand( GauGoEngine* engine, int argc, char** argv )
 {
   // No empty commands
   if( argc == 0 ){
-    GauGoEngine_sayError(UNKOWN_COMMAND);
+    GauGoEngine_sayError(engine, UNKOWN_COMMAND);
     return;
   }
 
   // Match command
-  CmdAndProcessor* it;
-  for( it = commandProcessors; it->commandName; it++ ){
-    if( strcmp( argv[0], it->commandName ) == 0 ){
-      (*(it->processor))(engine, argc, argv);
-      return;
-    }
+  CmdAndProcessor** it = bsearch( argv[0], commandIndex, commandsNum, 
+				  sizeof(*commandIndex), 
+				  &gauGoEngine_commandNameCmp );
+  if( it ){
+    (*((*it)->processor))(engine, argc, argv);
+    return;
   }
 
   // No match: error
-  GauGoEngine_sayError( UNKOWN_COMMAND );
+  GauGoEngine_sayError( engine, UNKOWN_COMMAND );
+}
+
+int GauGoEngine_tokenize( char* line, char** argv, int maxArgs )
+{
+  int argc = 0;
+  char* c = line;
+  while( *c && *c != '#' ){
+
+    // Separators
+    if( (unsigned char)*c <= ' ' || *c == 127 ){
+      c++;
+      continue;
+    }
+
+    // Argument, terminated in place
+    if( argc == maxArgs ) break;
+    argv[argc++] = c;
+    while( (unsigned char)*c > ' ' && *c != 127 && *c != '#' ) c++;
+    if( *c == '#' ){
+      *c = '\0';
+      break;
+    }
+    if( *c ) *c++ = '\0';
+  }
+  return argc;
+}
+
+void GauGoEngine_receiveGTPLine( GauGoEngine* engine, char* line )
+{
+  char* argv[GTP_ARGS_MAX];
+  int argc = GauGoEngine_tokenize( line, argv, GTP_ARGS_MAX );
+
+  // Empty lines are ignored
+  if( argc == 0 ) return;
+
+  // Command id
+  char** args = argv;
+  engine->gtpId = -1;
+  if( args[0][strspn( args[0], "0123456789" )] == '\0' ){
+    engine->gtpId = atoi( args[0] );
+    args++;
+    argc--;
+  }
+
+  GauGoEngine_receiveGTPCommand( engine, argc, args );
 }
 
 /**
- * @brief Send GTP error response to stdout
+ * @brief Send GTP error response
  *
- * @param error GTP error to send to stdout
+ * @param engine The engine
+ * @param error GTP error to send
  **/
-void GauGoEngine_sayError(GTPError error)
+void GauGoEngine_sayError(GauGoEngine* engine, GTPError error)
 {
   switch( error ){
-  case UNKOWN_COMMAND: printf("? unkown command\n\n"); break;
-  case ILLEGAL_MOVE:   printf("? illegal move\n\n"); break;
-  case WRONG_COLOR:  printf("? wrong color\n\n"); break;
-  case INVALID_SIZE:  printf("? invalid size\n\n"); break;
-  case FILE_NOT_FOUND:  printf("? file not found\n\n"); break;
-  case BAD_DATA: printf("? bad data\n\n"); break;
+  case UNKOWN_COMMAND: GauGoEngine_sayErrorCustom(engine, "unkown command"); break;
+  case ILLEGAL_MOVE:   GauGoEngine_sayErrorCustom(engine, "illegal move"); break;
+  case WRONG_COLOR:  GauGoEngine_sayErrorCustom(engine, "wrong color"); break;
+  case INVALID_SIZE:  GauGoEngine_sayErrorCustom(engine, "invalid size"); break;
+  case FILE_NOT_FOUND:  GauGoEngine_sayErrorCustom(engine, "file not found"); break;
+  case BAD_DATA: GauGoEngine_sayErrorCustom(engine, "bad data"); break;
   }
-
-  fflush(stdout);
 }
 
-void GauGoEngine_sayErrorCustom(const char* error)
+void GauGoEngine_sayErrorCustom(GauGoEngine* engine, const char* error)
 {
-  printf("? %s\n\n", error);
-  fflush(stdout);
+  fprintf(engine->out, "?");
+  if( engine->gtpId >= 0 ) fprintf(engine->out, "%d", engine->gtpId);
+  fprintf(engine->out, " %s\n\n", error);
+  fflush(engine->out);
 }
 
 /**
- * @brief Send GTP success response to stdout
+ * @brief Send GTP success response
  *
- * @param response GTP response to send to stdout
+ * @param engine The engine
+ * @param response GTP response to send
  **/
-void GauGoEngine_saySuccess(char* response)
+void GauGoEngine_saySuccess(GauGoEngine* engine, char* response)
+{
+  GauGoEngine_sayBegin(engine);
+  fprintf(engine->out, "%s\n\n", response);
+  fflush(engine->out);
+}
+
+void GauGoEngine_sayBegin(GauGoEngine* engine)
 {
-  printf("= %s\n\n", response);
-  fflush(stdout);
+  fprintf(engine->out, "=");
+  if( engine->gtpId >= 0 ) fprintf(engine->out, "%d", engine->gtpId);
+  fprintf(engine->out, " ");
 }
 
 void GauGoEngine_printCommandList(FILE* stream, char* format)
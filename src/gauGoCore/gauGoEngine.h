@@ -12,9 +12,18 @@
 
 #include "board.h"
 #include "uctTree.h"
+#include "uctSearch.h"
 #include "options.h"
+#include "timeControl.h"
 #include "global_defs.h"
 
+/**
+ * @brief Maximum number of arguments of a GTP command (command
+ * name included, id excluded): enough for a play_sequence of 
+ * a whole game
+ **/
+#define GTP_ARGS_MAX (2*HISTORY_LENGTH_MAX + 2)
+
 /**
  * @brief GTP errors
  *
@@ -37,21 +46,54 @@ typedef enum GTPError
  **/
 typedef struct GauGoEngine
 {
-  /** The current go board */
+  /** The current go board (points to position) */
   Board* board;
+  Board position;
 
-  /** History */
-  Board history[HISTORY_LENGTH_MAX];
+  /** History: the moves played from the empty board, and the hash
+      keys of all positions.  Positions are not stored, they are
+      rebuilt by replaying the moves.  Undone moves stay in the 
+      history until another move is played, for redo. */
   INTERSECTION historyMoves[HISTORY_LENGTH_MAX];
+  HashKey historyHashes[HISTORY_LENGTH_MAX];
   int historyLength;
   int currentHistoryPos;
 
   /** Last search tree */
   UCTTree lastTree;
 
+  /** Release the tree once the search is done, keeping only its
+      statistics (for engines hosting many games) */
+  int releaseTree;
+
+  /** Ownership and criticality of the last search, and the hash
+      key of the position it was made from */
+  PlayoutStats lastStats;
+  HashKey lastStatsHash;
+
   /** Options */
   Options options;
 
+  /** Playout policy selected in the options */
+  Policy policy;
+
+  /** Time settings and clocks */
+  TimeControl timeControl;
+
+  /** Set by the GTP reader thread when a stop or quit command
+      arrives, to interrupt the command being executed.  Cleared
+      when the next command is taken from the queue. */
+  volatile int stopRequested;
+
+  /** Set by the quit command, the engine must not be used anymore */
+  int quitRequested;
+
+  /** Stream for GTP responses (stdout by default) */
+  FILE* out;
+
+  /** Id of the GTP command being processed (-1: none) */
+  int gtpId;
+
 } GauGoEngine;
 
 /**
@@ -63,6 +105,77 @@ typedef struct GauGoEngine
  **/
 int GauGoEngine_initialize( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Initializes the tables shared by all the engines of the
+ * process (command index, zobrist values, patterns).  Must be called
+ * once before engines are used by several threads: afterwards the
+ * tables are only read.
+ *
+ * @param options The options
+ * @return 1 on success, 0 on error (reported on stderr)
+ **/
+int GauGoEngine_initializeShared( Options* options );
+
+/**
+ * @brief Initializes an engine with already parsed options, once the
+ * shared tables are initialized.  Does not seed the random generator
+ * of the calling thread.
+ *
+ * @param engine The engine
+ * @param options The options (copied)
+ * @return 1 on success, 0 if out of memory
+ **/
+int GauGoEngine_initializeWithOptions( GauGoEngine* engine, Options* options );
+
+/**
+ * @brief Releases the search tree and the policy of an engine
+ *
+ * @param engine The engine
+ **/
+void GauGoEngine_delete( GauGoEngine* engine );
+
+/**
+ * @brief Obtains the playout policy selected in the options
+ *
+ * @param engine The engine
+ * @return The policy instance
+ **/
+Policy* GauGoEngine_policy( GauGoEngine* engine );
+
+/**
+ * @brief Prepares a search from the current position, in a new tree
+ * that replaces the last one.  The search can be interrupted by the
+ * stop command.
+ *
+ * @param engine The engine
+ * @param search The search to initialize
+ * @param stopper The search stopper
+ **/
+void GauGoEngine_initializeSearch( GauGoEngine* engine, UCTSearch* search,
+				   STOPPER stopper );
+
+/**
+ * @brief Keeps the results of a finished search for analysis commands,
+ * and releases the tree if the engine does not keep it
+ *
+ * @param engine The engine
+ * @param search The search
+ **/
+void GauGoEngine_searchDone( GauGoEngine* engine, UCTSearch* search );
+
+/**
+ * @brief Searches a move for the player to play, in the time given
+ * by the time control or for a fixed number of simulations, and 
+ * plays it.  Passes without searching when there is no legal move.
+ *
+ * @param engine The engine
+ * @param playouts Receives the playouts of the search (may be NULL)
+ * @param elapsed Receives the time of the search in ms (may be NULL)
+ * @return The move played
+ **/
+INTERSECTION GauGoEngine_genmove( GauGoEngine* engine, int* playouts,
+				  int* elapsed );
+
 /**
  * @brief Reset engine board and history to initial position
  *
@@ -88,16 +201,48 @@ UCTNode* GauGoEngine_getTreePos( GauGoEngine* engine );
  **/
 void GauGoEngine_receiveGTPCommand( GauGoEngine* engine, int argc, char** argv );
 
+/**
+ * @brief Processes a received GTP command line: splits it into
+ * arguments (in place, without allocations), takes the command id
+ * if any, and processes the command.  Comments are dropped, and
+ * empty lines ignored.
+ *
+ * @param engine The engine
+ * @param line The command line, without newline (modified)
+ **/
+void GauGoEngine_receiveGTPLine( GauGoEngine* engine, char* line );
+
+/**
+ * @brief Splits a GTP command line into arguments, in place.
+ * Arguments are separated by spaces and control characters, and
+ * everything after a '#' is a comment.
+ *
+ * @param line The command line (modified)
+ * @param argv Receives the arguments, pointing into line
+ * @param maxArgs Size of argv (more arguments are dropped)
+ * @return The number of arguments
+ **/
+int GauGoEngine_tokenize( char* line, char** argv, int maxArgs );
+
 /**
  * @brief Play a move to the engine's board.
- * This method also saves current position in history, so that the 
- * move can be undone later on
+ * This method also saves the move in history, so that it can be 
+ * undone later on
  *
  * @param engine The engine
  * @param move The move
  **/
 void GauGoEngine_play(GauGoEngine* engine, INTERSECTION move);
 
+/**
+ * @brief Goes back to an earlier position of the history, by 
+ * replaying the game up to it.  Later moves can be redone.
+ *
+ * @param engine The engine
+ * @param historyPos The position (number of moves from the empty board)
+ **/
+void GauGoEngine_rewind(GauGoEngine* engine, int historyPos);
+
 /**
  * @brief Undo last move if possible
  *
@@ -115,25 +260,36 @@ int GauGoEngine_undo(GauGoEngine* engine);
 int GauGoEngine_redo(GauGoEngine* engine);
 
 /**
- * @brief Send GTP error response to stdout
+ * @brief Send GTP error response
  *
- * @param error GTP error to send to stdout
+ * @param engine The engine
+ * @param error GTP error to send
  **/
-void GauGoEngine_sayError(GTPError error);
+void GauGoEngine_sayError(GauGoEngine* engine, GTPError error);
 
 /**
- * @brief Send GTP custom error response to stdout
+ * @brief Send GTP custom error response
  *
+ * @param engine The engine
  * @param error Error message
  **/
-void GauGoEngine_sayErrorCustom(const char* error);
+void GauGoEngine_sayErrorCustom(GauGoEngine* engine, const char* error);
+
+/**
+ * @brief Send GTP success response
+ *
+ * @param engine The engine
+ * @param response GTP response to send
+ **/
+void GauGoEngine_saySuccess(GauGoEngine* engine, char* response);
 
 /**
- * @brief Send GTP success response to stdout
+ * @brief Starts a GTP success response ("=" and the command id), 
+ * for commands that print the rest of it themselves
  *
- * @param response GTP response to send to stdout
+ * @param engine The engine
  **/
-void GauGoEngine_saySuccess(char* response);
+void GauGoEngine_sayBegin(GauGoEngine* engine);
 
 /**
  * @brief Prints the list of all available GTP commands
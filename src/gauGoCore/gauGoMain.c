@@ -5,53 +5,187 @@
  * controller from other programs or directly from the command line.
  *
  * This file controls the main function and program entry point behaviour.
- * 
+ * GTP commands are read by a reader thread and queued, the main thread
+ * executes them in order.  The reader thread interrupts the command
+ * being executed as soon as a stop or quit command arrives, the
+ * commands queued before it still run in full.
+ * With the --server option, the program hosts many games instead
+ * (see gauGoServer.h).
+ *
  **/
 
 #include <stdio.h>
 #include <string.h>
-#include <wordexp.h>
+#include <pthread.h>
 
 #include "gauGoEngine.h"
+#include "gauGoServer.h"
+
+/** @brief Longest command line (a play_sequence of a whole game) */
+#define BUF_SIZE 8192
+
+/** @brief Maximum number of commands waiting to be executed */
+#define QUEUE_SIZE 64
+
+/**
+ * @brief Commands read but not executed yet
+ **/
+typedef struct CommandQueue
+{
+  // Ring buffer of command lines, and whether they were too long
+  char lines[QUEUE_SIZE][BUF_SIZE];
+  int tooLong[QUEUE_SIZE];
+  int first;
+  int num;
+
+  // Input closed, no more commands after the queued ones
+  int closed;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t notEmpty;
+  pthread_cond_t notFull;
+
+} CommandQueue;
+
+/**
+ * @brief Single global state of the program, and its command queue
+ * (static: too large for the stack)
+ **/
+static GauGoEngine engine;
+static CommandQueue queue = {
+  .mutex = PTHREAD_MUTEX_INITIALIZER,
+  .notEmpty = PTHREAD_COND_INITIALIZER,
+  .notFull = PTHREAD_COND_INITIALIZER
+};
 
-/** @brief Quite standard buffer size */
-#define BUF_SIZE 512
+/**
+ * @brief Determines if a command line is the specified command,
+ * with or without GTP id
+ *
+ * @param line The command line
+ * @param name The command name
+ * @return 1 if it is, 0 otherwise
+ **/
+int main_isCommand( const char* line, const char* name )
+{
+  char copy[BUF_SIZE];
+  char* args[2];
+  strcpy( copy, line );
+  int argc = GauGoEngine_tokenize( copy, args, 2 );
+  if( argc >= 1 && strcmp( args[0], name ) == 0 ) return 1;
+  return argc == 2 && args[0][strspn(args[0], "0123456789")] == '\0'
+    && strcmp( args[1], name ) == 0;
+}
+
+/**
+ * @brief Reader thread: reads GTP commands from stdin and queues them,
+ * interrupting the command being executed on stop and quit
+ **/
+void* main_reader( void* arg )
+{
+  (void)arg;
+  char inputBuffer[BUF_SIZE];
+  int quit = 0;
+  while( !quit ){
+    // Input closed: the queued commands still run
+    if( fgets( inputBuffer, BUF_SIZE, stdin ) == NULL ) break;
+
+    // Line too long: drop the rest of it
+    int tooLong = strchr( inputBuffer, '\n' ) == NULL && !feof( stdin );
+    if( tooLong ){
+      int c;
+      while( (c = getchar()) != '\n' && c != EOF );
+    }
+
+    // Remove trailing /n character
+    inputBuffer [ strcspn(inputBuffer, "\n") ] = '\0';
+
+    quit = main_isCommand( inputBuffer, "quit" );
+    int stop = quit || main_isCommand( inputBuffer, "stop" );
+
+    pthread_mutex_lock( &queue.mutex );
+    // Interrupt the command being executed at once, the stop itself
+    // is answered in turn
+    if( stop ) engine.stopRequested = 1;
+    while( queue.num == QUEUE_SIZE ){
+      pthread_cond_wait( &queue.notFull, &queue.mutex );
+    }
+    int last = (queue.first + queue.num++) % QUEUE_SIZE;
+    strcpy( queue.lines[last], inputBuffer );
+    queue.tooLong[last] = tooLong;
+    pthread_cond_signal( &queue.notEmpty );
+    pthread_mutex_unlock( &queue.mutex );
+  }
+
+  // No more commands
+  pthread_mutex_lock( &queue.mutex );
+  queue.closed = 1;
+  pthread_cond_signal( &queue.notEmpty );
+  pthread_mutex_unlock( &queue.mutex );
+  return NULL;
+}
+
+/**
+ * @brief Takes the next command from the queue, waiting for it
+ *
+ * @param line Receives the command line
+ * @param tooLong Receives whether the line was too long (truncated)
+ * @return 1 on success, 0 if there are no more commands
+ **/
+int main_nextCommand( char* line, int* tooLong )
+{
+  pthread_mutex_lock( &queue.mutex );
+  while( queue.num == 0 && !queue.closed ){
+    pthread_cond_wait( &queue.notEmpty, &queue.mutex );
+  }
+  int got = queue.num > 0;
+  if( got ){
+    // Only stops read from now on interrupt this command
+    engine.stopRequested = 0;
+    strcpy( line, queue.lines[queue.first] );
+    *tooLong = queue.tooLong[queue.first];
+    queue.first = (queue.first + 1) % QUEUE_SIZE;
+    queue.num--;
+    pthread_cond_signal( &queue.notFull );
+  }
+  pthread_mutex_unlock( &queue.mutex );
+  return got;
+}
 
 /**
  * @brief GauGo GTP engine main
  **/
 int main(int argc, char** argv)
 {
-  // Single global state of the program
-  GauGoEngine engine;
   if (!GauGoEngine_initialize( &engine, argc, argv ) ){
     // Initialization error, stop
     return 1;
   }
-  
-  // Main thread: wait for GTP commands
-  char inputBuffer[BUF_SIZE];
-  while(1){
-    if( fgets( inputBuffer, BUF_SIZE, stdin ) == NULL ){
-      // Input closed (parent program terminated?), stop
-      return 0;
-    }
-    fflush(stdin);
 
-    // Remove trailing /n character
-    inputBuffer [ strlen(inputBuffer) - 1 ] = '\0';
-    
-    // Parse the GTP command (POSIX wordexp)
-    wordexp_t args;
-    int res = wordexp( inputBuffer, &args, 0 );
-    if( res == 0 ){
-      GauGoEngine_receiveGTPCommand( &engine, args.we_wordc, args.we_wordv );
-    }
-    else{
-      GauGoEngine_sayError(UNKOWN_COMMAND);
+  // Multi-game server: this engine only read the options
+  if( engine.options.serverWorkers > 0 ){
+    return GauGoServer_run( &engine.options );
+  }
+
+  // Reader thread
+  pthread_t reader;
+  if( pthread_create( &reader, NULL, &main_reader, NULL ) != 0 ){
+    fprintf(stderr, "Cannot start the GTP reader thread\n");
+    return 1;
+  }
+
+  // Main thread: execute GTP commands
+  static char inputBuffer[BUF_SIZE];
+  int tooLong;
+  while( main_nextCommand( inputBuffer, &tooLong ) ){
+    if( tooLong ){
+      engine.gtpId = -1;
+      GauGoEngine_sayErrorCustom( &engine, "line too long" );
+      continue;
     }
-    
-    // Free wordexp
-    wordfree( &args );
+    GauGoEngine_receiveGTPLine( &engine, inputBuffer );
+    if( engine.quitRequested ) break;
   }
+
+  return 0;
 }
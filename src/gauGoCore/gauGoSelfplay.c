@@ -0,0 +1,370 @@
+/**
+ * @file gauGoSelfplay.c
+ * @brief Self-play match between two option sets of the engine.
+ *
+ * Both players are engines of this process: games are played in
+ * parallel by worker threads, without GTP in between.  The players
+ * alternate colors, game 0 is played by A with black.
+ *
+ * Usage: gauGoSelfplay -A "engine options" -B "engine options"
+ *        [-g games] [-t threads] [-T main time] [-o sgf prefix]
+ *
+ * With a main time, games are sudden death: a player whose searches
+ * exceed it loses on time.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <getopt.h>
+#include <pthread.h>
+
+#include "gauGoEngine.h"
+#include "GTPArchiving.h"
+#include "scoring.h"
+#include "crash.h"
+#include "rng.h"
+
+/** @brief Longest option set */
+#define SELFPLAY_OPTIONS_MAX 1024
+
+/**
+ * @brief Results of one player
+ **/
+typedef struct PlayerStats
+{
+  /** Games won (jigo: half a win), in total and with black */
+  float wins;
+  float blackWins;
+  int blackGames;
+
+  /** Games lost on time */
+  int timeLosses;
+
+  /** Moves played, playouts and time (ms) of their searches */
+  long long moves;
+  long long playouts;
+  long long time;
+
+} PlayerStats;
+
+/**
+ * @brief The match: settings and results so far
+ **/
+typedef struct Match
+{
+  /** Options of the players, their command lines, and the
+      arguments the options point into */
+  Options options[2];
+  char optionsLine[2][SELFPLAY_OPTIONS_MAX];
+  char args[2][SELFPLAY_OPTIONS_MAX];
+  char* argv[2][GTP_ARGS_MAX];
+
+  int games;
+  int threads;
+
+  /** Main time of every player, sudden death (s, 0: fixed
+      simulations) */
+  int mainTime;
+
+  /** Sgf files prefix (NULL: no files) */
+  char* sgfPrefix;
+
+  /** Next game to be played, and results */
+  int nextGame;
+  int jigos;
+  PlayerStats stats[2];
+
+  /** Protects the results, and the sgf library */
+  pthread_mutex_t mutex;
+
+} Match;
+
+static Match match = {
+  .games = 10,
+  .threads = 1,
+  .mutex = PTHREAD_MUTEX_INITIALIZER
+};
+
+/** @brief Player names */
+static const char* playerNames[2] = { "A", "B" };
+
+/**
+ * @brief Parses the options of a player
+ *
+ * @param player 0 for A, 1 for B
+ * @param line The options
+ * @return 1 on success, 0 if too long
+ **/
+int selfplay_parseOptions( int player, const char* line )
+{
+  if( strlen(line) >= SELFPLAY_OPTIONS_MAX - 1 ) return 0;
+  strcpy( match.optionsLine[player], line );
+  strcpy( match.args[player], line );
+
+  // Program name, then the options
+  match.argv[player][0] = "gauGoSelfplay";
+  int argc = 1 + GauGoEngine_tokenize( match.args[player], 
+				       match.argv[player] + 1,
+				       GTP_ARGS_MAX - 2 );
+  match.argv[player][argc] = NULL;
+  Options_initialize( &match.options[player], argc, match.argv[player] );
+
+  // Search logs of parallel games would be mixed
+  match.options[player].verbosity = 0;
+  match.options[player].gogui = 0;
+  return 1;
+}
+
+/**
+ * @brief Plays one game between the players
+ *
+ * @param game The game number
+ **/
+void selfplay_game( int game )
+{
+  // Player with black
+  int black = game % 2;
+
+  GauGoEngine engines[2];
+  for( int p=0; p<2; p++ ){
+    if( !GauGoEngine_initializeWithOptions( &engines[p], &match.options[p] ) ){
+      fprintf( stderr, "Cannot set up the engines of game %d\n", game );
+      exit( 1 );
+    }
+    if( match.mainTime ){
+      TimeControl_set( &engines[p].timeControl, match.mainTime*1000,
+		       BYOYOMI_NONE, 0, 0 );
+    }
+  }
+
+  PlayerStats stats[2];
+  memset( stats, 0, sizeof(stats) );
+
+  // Until both pass, the history is full, or a player runs out of time
+  int passes = 0, timeLoser = -1;
+  while( passes < 2 && timeLoser < 0
+	 && engines[0].currentHistoryPos < HISTORY_LENGTH_MAX-2 ){
+    Color turn = engines[0].board->turn;
+    int p = turn == BLACK ? black : 1-black;
+    int playouts, elapsed;
+    INTERSECTION move = GauGoEngine_genmove( &engines[p], &playouts, &elapsed );
+    GauGoEngine_play( &engines[1-p], move );
+    gauAssert( engines[0].board->hashKey == engines[1].board->hashKey,
+	       engines[p].board, NULL );
+
+    passes = move == PASS ? passes+1 : 0;
+    stats[p].moves++;
+    stats[p].playouts += playouts;
+    stats[p].time += elapsed;
+
+    // Sudden death: no byo-yomi to fall back on
+    if( match.mainTime && engines[p].timeControl.clocks[turn].timeLeft < 0 ){
+      timeLoser = p;
+    }
+  }
+
+  // Final score, or a win on time, as sgf writes results
+  float score;
+  char result[16];
+  if( timeLoser >= 0 ){
+    score = timeLoser == black ? -1 : 1;
+    sprintf( result, "%c+T", score > 0 ? 'B' : 'W' );
+  }
+  else{
+    Options* options = &match.options[black];
+    score = Scoring_finalScore( engines[black].board, options->komi,
+				options->scoringPlayouts );
+    if( score == 0 ) strcpy( result, "0" );
+    else sprintf( result, "%c+%.1f", score > 0 ? 'B' : 'W', fabsf(score) );
+  }
+
+  pthread_mutex_lock( &match.mutex );
+
+  // Results
+  int winner = score > 0 ? black : 1-black;
+  if( score == 0 ) match.jigos++;
+  if( timeLoser >= 0 ) match.stats[timeLoser].timeLosses++;
+  for( int p=0; p<2; p++ ){
+    float win = score == 0 ? 0.5f : (p == winner);
+    match.stats[p].wins += win;
+    if( p == black ){
+      match.stats[p].blackGames++;
+      match.stats[p].blackWins += win;
+    }
+    match.stats[p].moves += stats[p].moves;
+    match.stats[p].playouts += stats[p].playouts;
+    match.stats[p].time += stats[p].time;
+  }
+
+  printf( "Game %d: %s (B) - %s (W) %s, %d moves\n", game,
+	  playerNames[black], playerNames[1-black],
+	  score == 0 ? "jigo" : result,
+	  engines[0].currentHistoryPos );
+
+  // Game record
+  if( match.sgfPrefix ){
+    char fileName[FILENAME_MAX];
+    snprintf( fileName, sizeof(fileName), "%s%04d.sgf",
+	      match.sgfPrefix, game );
+    if( !GTPArchiving_writeGame( &engines[0], fileName,
+				 playerNames[black], playerNames[1-black],
+				 result ) ){
+      fprintf( stderr, "Cannot write %s\n", fileName );
+    }
+  }
+  fflush( stdout );
+
+  pthread_mutex_unlock( &match.mutex );
+
+  for( int p=0; p<2; p++ ) GauGoEngine_delete( &engines[p] );
+}
+
+/**
+ * @brief Worker thread: plays games until all are started
+ *
+ * @param arg The worker index
+ **/
+void* selfplay_worker( void* arg )
+{
+  // Different games in every worker
+  unsigned long long seed = match.options[0].seed ?
+    match.options[0].seed : (unsigned long long)time(NULL);
+  Rng_seed( &threadRng, seed + (size_t)arg );
+
+  while( 1 ){
+    pthread_mutex_lock( &match.mutex );
+    int game = match.nextGame < match.games ? match.nextGame++ : -1;
+    pthread_mutex_unlock( &match.mutex );
+    if( game < 0 ) break;
+
+    selfplay_game( game );
+  }
+  return NULL;
+}
+
+/**
+ * @brief Prints the results of the match: win rate of A with its
+ * 95% confidence interval (Wilson score), the games the players lost
+ * on time, and their averages per move
+ **/
+void selfplay_printResults()
+{
+  int n = match.games;
+  double p = match.stats[0].wins / n;
+  double z = 1.96;
+  double center = (p + z*z/(2*n)) / (1 + z*z/n);
+  double margin = z * sqrt( p*(1-p)/n + z*z/(4.0*n*n) ) / (1 + z*z/n);
+
+  printf( "\nGames: %d (A %.1f, B %.1f, jigo %d)\n", n,
+	  match.stats[0].wins, match.stats[1].wins, match.jigos );
+  printf( "A win rate: %.1f%% (95%% CI %.1f%% - %.1f%%)\n", 100*p,
+	  100*(center - margin), 100*(center + margin) );
+
+  printf( "\n%-6s %-8s %-8s %-8s %-8s %-10s %s\n", "", "black", "white",
+	  "timeouts", "moves", "ms/move", "playouts/move" );
+  for( int i=0; i<2; i++ ){
+    PlayerStats* s = &match.stats[i];
+    int whiteGames = n - s->blackGames;
+    char black[16], white[16];
+    sprintf( black, "%.1f/%d", s->blackWins, s->blackGames );
+    sprintf( white, "%.1f/%d", s->wins - s->blackWins, whiteGames );
+    long long moves = MAX( s->moves, 1 );
+    printf( "%-6s %-8s %-8s %-8d %-8lld %-10.1f %.0f\n", playerNames[i],
+	    black, white, s->timeLosses, s->moves, (double)s->time / moves,
+	    (double)s->playouts / moves );
+  }
+  for( int i=0; i<2; i++ ){
+    printf( "%s: %s\n", playerNames[i], match.optionsLine[i] );
+  }
+}
+
+/**
+ * @brief GauGo self-play main
+ **/
+int main( int argc, char** argv )
+{
+  static struct option long_options[] = {
+    {"options_a", required_argument, 0, 'A'},
+    {"options_b", required_argument, 0, 'B'},
+    {"games", required_argument, 0, 'g'},
+    {"threads", required_argument, 0, 't'},
+    {"time", required_argument, 0, 'T'},
+    {"sgf", required_argument, 0, 'o'},
+    {0,         0,                 0,  0 }
+  };
+  char* optionsLine[2] = { "", "" };
+  int c, option_index;
+
+  while(1){
+    c = getopt_long(argc, argv, "A:B:g:t:T:o:", long_options, &option_index);
+    if( c==-1 ) break;
+    switch(c){
+      // Options of the players
+    case 'A': optionsLine[0] = optarg; break;
+    case 'B': optionsLine[1] = optarg; break;
+      // Games, and games played at the same time
+    case 'g': match.games = atoi(optarg); break;
+    case 't': match.threads = atoi(optarg); break;
+      // Main time (s), sudden death
+    case 'T': match.mainTime = atoi(optarg); break;
+      // Sgf files
+    case 'o': match.sgfPrefix = optarg; break;
+    default:
+      fprintf(stderr, "Usage: %s -A \"engine options\" -B \"engine options\""
+	      " [-g games] [-t threads] [-T main time] [-o sgf prefix]\n",
+	      argv[0]);
+      return 1;
+    }
+  }
+  if( match.games <= 0 || match.threads <= 0 ){
+    fprintf(stderr, "Games and threads must be positive\n");
+    return 1;
+  }
+
+  for( int p=0; p<2; p++ ){
+    if( !selfplay_parseOptions( p, optionsLine[p] ) ){
+      fprintf(stderr, "Options of %s too long\n", playerNames[p]);
+      return 1;
+    }
+  }
+
+  // Same game for both players
+  Options* a = &match.options[0];
+  Options* b = &match.options[1];
+  if( a->boardSize != b->boardSize || a->komi != b->komi ){
+    fprintf(stderr, "Board size and komi must be the same for both players\n");
+    return 1;
+  }
+  // Pattern weights are shared by all engines
+  if( (a->patternWeightsFile || b->patternWeightsFile)
+      && ( !a->patternWeightsFile || !b->patternWeightsFile
+	   || strcmp( a->patternWeightsFile, b->patternWeightsFile ) ) ){
+    fprintf(stderr, "Pattern weights must be the same for both players\n");
+    return 1;
+  }
+
+  // Tables shared by the engines, before the workers start
+  for( int p=0; p<2; p++ ){
+    if( !GauGoEngine_initializeShared( &match.options[p] ) ) return 1;
+  }
+
+  pthread_t* workers = malloc( match.threads * sizeof(pthread_t) );
+  for( int i=0; i<match.threads; i++ ){
+    if( pthread_create( &workers[i], NULL, &selfplay_worker,
+			(void*)(size_t)i ) != 0 ){
+      fprintf(stderr, "Cannot start the worker threads\n");
+      return 1;
+    }
+  }
+  for( int i=0; i<match.threads; i++ ){
+    pthread_join( workers[i], NULL );
+  }
+  free( workers );
+
+  selfplay_printResults();
+  return 0;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file  gauGoServer.c
+ * @brief Multi-game server implementation
+ *
+ * The main thread reads the commands and appends them to the pending
+ * commands of their game, a game with pending commands waits in the
+ * ready queue for a worker.  A worker executes one command of a game
+ * at a time, then puts it back at the end of the queue if it has more:
+ * no game can hold a worker while others are waiting.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "gauGoServer.h"
+#include "gauGoEngine.h"
+#include "rng.h"
+
+/** @brief Longest command line (a play_sequence of a whole game) */
+#define SERVER_LINE_MAX 8192
+
+/**
+ * @brief A command waiting to be executed
+ **/
+typedef struct ServerCommand
+{
+  struct ServerCommand* next;
+  char line[];
+
+} ServerCommand;
+
+/**
+ * @brief A hosted game
+ **/
+typedef struct ServerGame
+{
+  int id;
+  GauGoEngine engine;
+
+  /** Responses of the engine, written to stdout once complete */
+  FILE* out;
+  char* outBuffer;
+  size_t outSize;
+
+  /** Commands waiting to be executed */
+  ServerCommand* first;
+  ServerCommand* last;
+
+  /** In the ready queue or being executed */
+  int scheduled;
+  struct ServerGame* nextReady;
+
+} ServerGame;
+
+/**
+ * @brief Server state, shared by the reader and the workers
+ **/
+typedef struct Server
+{
+  Options* options;
+  ServerGame* games[SERVER_GAMES_MAX];
+
+  /** Games with commands to execute, and no worker on them */
+  ServerGame* firstReady;
+  ServerGame* lastReady;
+
+  /** Input closed, no more commands after the pending ones */
+  int closed;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t ready;
+
+  /** Serializes the responses on stdout */
+  pthread_mutex_t outMutex;
+
+} Server;
+
+static Server server = {
+  .mutex = PTHREAD_MUTEX_INITIALIZER,
+  .ready = PTHREAD_COND_INITIALIZER,
+  .outMutex = PTHREAD_MUTEX_INITIALIZER
+};
+
+/**
+ * @brief Writes a response to stdout, prefixed by the game id
+ *
+ * @param gameId The game id (-1: response of the server itself)
+ * @param response The response
+ * @param size The response length
+ **/
+void server_write( int gameId, const char* response, size_t size )
+{
+  pthread_mutex_lock( &server.outMutex );
+  if( gameId >= 0 ) printf( "%d ", gameId );
+  fwrite( response, 1, size, stdout );
+  fflush( stdout );
+  pthread_mutex_unlock( &server.outMutex );
+}
+
+/**
+ * @brief Creates a game and its engine
+ *
+ * @param id The game id
+ * @return The game, NULL if out of memory
+ **/
+ServerGame* server_newGame( int id )
+{
+  ServerGame* game = malloc( sizeof(ServerGame) );
+  if( !game ) return NULL;
+
+  game->out = open_memstream( &game->outBuffer, &game->outSize );
+  if( !game->out ){
+    free( game );
+    return NULL;
+  }
+
+  game->id = id;
+  game->first = game->last = NULL;
+  game->scheduled = 0;
+  game->nextReady = NULL;
+  if( !GauGoEngine_initializeWithOptions( &game->engine, server.options ) ){
+    fclose( game->out );
+    free( game->outBuffer );
+    free( game );
+    return NULL;
+  }
+  game->engine.out = game->out;
+  // Idle games only keep the statistics of their last search
+  game->engine.releaseTree = 1;
+  return game;
+}
+
+/**
+ * @brief Deletes a game and its engine
+ **/
+void server_deleteGame( ServerGame* game )
+{
+  GauGoEngine_delete( &game->engine );
+  fclose( game->out );
+  free( game->outBuffer );
+  free( game );
+}
+
+/**
+ * @brief Appends a command to the pending commands of a game,
+ * creating the game if needed.  To be called with the mutex locked.
+ *
+ * @param id The game id
+ * @param command The command
+ * @return 1 on success, 0 if the game cannot be created
+ **/
+int server_submit( int id, ServerCommand* command )
+{
+  ServerGame* game = server.games[id];
+  if( !game ){
+    game = server.games[id] = server_newGame( id );
+    if( !game ) return 0;
+  }
+
+  command->next = NULL;
+  if( game->last ) game->last->next = command;
+  else game->first = command;
+  game->last = command;
+
+  if( !game->scheduled ){
+    game->scheduled = 1;
+    game->nextReady = NULL;
+    if( server.lastReady ) server.lastReady->nextReady = game;
+    else server.firstReady = game;
+    server.lastReady = game;
+    pthread_cond_signal( &server.ready );
+  }
+  return 1;
+}
+
+/**
+ * @brief Worker thread: executes the commands of the ready games
+ *
+ * @param arg The worker index
+ **/
+void* server_worker( void* arg )
+{
+  // Different playouts in every worker
+  unsigned long long seed = server.options->seed ?
+    server.options->seed : (unsigned long long)time(NULL);
+  Rng_seed( &threadRng, seed + (size_t)arg );
+
+  pthread_mutex_lock( &server.mutex );
+  while( 1 ){
+    while( !server.firstReady && !server.closed ){
+      pthread_cond_wait( &server.ready, &server.mutex );
+    }
+    if( !server.firstReady ) break;
+
+    // Takes the first command of the first ready game
+    ServerGame* game = server.firstReady;
+    server.firstReady = game->nextReady;
+    if( !server.firstReady ) server.lastReady = NULL;
+    ServerCommand* command = game->first;
+    game->first = command->next;
+    if( !game->first ) game->last = NULL;
+    // Only stops read from now on interrupt this command
+    game->engine.stopRequested = 0;
+    pthread_mutex_unlock( &server.mutex );
+
+    // Executes it
+    GauGoEngine_receiveGTPLine( &game->engine, command->line );
+    free( command );
+    fflush( game->out );
+    if( game->outSize > 0 ){
+      server_write( game->id, game->outBuffer, game->outSize );
+      fseeko( game->out, 0, SEEK_SET );
+    }
+
+    pthread_mutex_lock( &server.mutex );
+    if( game->engine.quitRequested ){
+      // Game over, later commands with its id go to a new game
+      ServerCommand* pending = game->first;
+      server.games[game->id] = NULL;
+      while( pending ){
+	ServerCommand* next = pending->next;
+	if( !server_submit( game->id, pending ) ) free( pending );
+	pending = next;
+      }
+      pthread_mutex_unlock( &server.mutex );
+      server_deleteGame( game );
+      pthread_mutex_lock( &server.mutex );
+    }
+    else if( game->first ){
+      // Back in the queue, behind the other ready games
+      game->nextReady = NULL;
+      if( server.lastReady ) server.lastReady->nextReady = game;
+      else server.firstReady = game;
+      server.lastReady = game;
+    }
+    else game->scheduled = 0;
+  }
+  pthread_mutex_unlock( &server.mutex );
+  return NULL;
+}
+
+/**
+ * @brief Determines if a command line (without game id) is the
+ * specified command, with or without GTP id
+ **/
+int server_isCommand( const char* line, const char* name )
+{
+  char copy[SERVER_LINE_MAX];
+  char* args[2];
+  strcpy( copy, line );
+  int argc = GauGoEngine_tokenize( copy, args, 2 );
+  if( argc >= 1 && strcmp( args[0], name ) == 0 ) return 1;
+  return argc == 2 && args[0][strspn(args[0], "0123456789")] == '\0'
+    && strcmp( args[1], name ) == 0;
+}
+
+int GauGoServer_run( Options* options )
+{
+  server.options = options;
+
+  int workersNum = options->serverWorkers;
+  pthread_t* workers = malloc( workersNum * sizeof(pthread_t) );
+  for( int i=0; i<workersNum; i++ ){
+    if( pthread_create( &workers[i], NULL, &server_worker,
+			(void*)(size_t)i ) != 0 ){
+      fprintf(stderr, "Cannot start the server worker threads\n");
+      return 1;
+    }
+  }
+
+  static char inputBuffer[SERVER_LINE_MAX];
+  while( fgets( inputBuffer, SERVER_LINE_MAX, stdin ) ){
+    // Line too long: drop the rest of it
+    int tooLong = strchr( inputBuffer, '\n' ) == NULL && !feof( stdin );
+    if( tooLong ){
+      int c;
+      while( (c = getchar()) != '\n' && c != EOF );
+    }
+    inputBuffer[ strcspn(inputBuffer, "\n") ] = '\0';
+
+    // Game id
+    char* line = inputBuffer + strspn( inputBuffer, " \t\r" );
+    if( *line == '\0' ) continue;
+    char* end;
+    long id = strtol( line, &end, 10 );
+    if( end == line || (*end && *end != ' ' && *end != '\t')
+	|| id < 0 || id >= SERVER_GAMES_MAX ){
+      const char error[] = "? invalid game id\n\n";
+      server_write( -1, error, sizeof(error)-1 );
+      continue;
+    }
+    if( tooLong ){
+      const char error[] = "? line too long\n\n";
+      server_write( id, error, sizeof(error)-1 );
+      continue;
+    }
+    line = end;
+
+    ServerCommand* command = malloc( sizeof(ServerCommand) + strlen(line) + 1 );
+    strcpy( command->line, line );
+
+    pthread_mutex_lock( &server.mutex );
+    // Interrupts the command being executed at once, the stop itself is
+    // answered in turn
+    ServerGame* game = server.games[id];
+    if( game && ( server_isCommand( line, "stop" )
+		  || server_isCommand( line, "quit" ) ) ){
+      game->engine.stopRequested = 1;
+    }
+    int submitted = server_submit( id, command );
+    pthread_mutex_unlock( &server.mutex );
+
+    if( !submitted ){
+      free( command );
+      const char error[] = "? out of memory\n\n";
+      server_write( id, error, sizeof(error)-1 );
+    }
+  }
+
+  // Input closed: executes the pending commands and stops
+  pthread_mutex_lock( &server.mutex );
+  server.closed = 1;
+  pthread_cond_broadcast( &server.ready );
+  pthread_mutex_unlock( &server.mutex );
+
+  for( int i=0; i<workersNum; i++ ){
+    pthread_join( workers[i], NULL );
+  }
+  free( workers );
+
+  for( int i=0; i<SERVER_GAMES_MAX; i++ ){
+    if( server.games[i] ) server_deleteGame( server.games[i] );
+  }
+  return 0;
+}
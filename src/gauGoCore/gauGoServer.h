@@ -0,0 +1,39 @@
+/**
+ * @file  gauGoServer.h
+ * @brief Multi-game server: one process hosting many engines
+ *
+ * Every input line is a GTP command prefixed by a game id:
+ *
+ *   <game> [id] command [arguments]
+ *
+ * An engine is created for a game at its first command, and deleted
+ * by its quit command (the id can then be used again for a new game).
+ * Commands of a game are executed in order, commands of different
+ * games in parallel by a pool of worker threads.  The response to
+ * every command is written at once, when complete, prefixed by the
+ * game id; like in GTP it ends with an empty line.  Hosted engines
+ * share the zobrist values and pattern tables of the process.
+ *
+ **/
+#ifndef GAUGO_SERVER_H
+#define GAUGO_SERVER_H
+
+#include "options.h"
+
+/**
+ * @brief Maximum number of games hosted at the same time,
+ * and maximum game id + 1
+ **/
+#define SERVER_GAMES_MAX 4096
+
+/**
+ * @brief Runs the server on stdin and stdout until the input is
+ * closed and all its commands are executed.  The shared tables must
+ * be initialized (see GauGoEngine_initializeShared).
+ *
+ * @param options The options of all hosted engines
+ * @return The program exit code
+ **/
+int GauGoServer_run( Options* options );
+
+#endif
@@ -24,12 +24,6 @@
  **/
 #define HISTORY_LENGTH_MAX 512
 
-/**
- * @brief Max number of previous board states
- * to be checked for super-ko inside tree search
- **/
-#define SUPERKO_HISTORY_MAX 8
-
 /**
  * @brief The maximum number of needed intersection data
  * in order to represent a go board of size MAX_BOARD_SIZE.
@@ -44,6 +38,15 @@
  **/
 #define PLAYOUT_MOVES_MAX 512
 
+/**
+ * @brief If defined (-DEXACT_LIBERTIES), stone groups keep the exact
+ * set of their liberties along with the pseudo-liberty sums, so that
+ * they can be listed without browsing the stones (see Board_liberties).
+ * Off by default: the sets make the board three times larger, and
+ * every simulation copies it.
+ **/
+/* #define EXACT_LIBERTIES */
+
 /**
  * @brief Type used to index stone groups in the stone group pool
  **/
@@ -72,7 +75,7 @@ typedef short INTERSECTION;
 /**
  * Max/min utils
  **/
-#define MAX(a, b) (a)>(b)?(a):(b)
-#define MIN(a, b) (a)<(b)?(a):(b)
+#define MAX(a, b) ((a)>(b)?(a):(b))
+#define MIN(a, b) ((a)<(b)?(a):(b))
 
 #endif
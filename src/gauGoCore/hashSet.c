@@ -0,0 +1,60 @@
+/**
+ * @file hashSet.c
+ * @brief HashSet implementation
+ *
+ **/
+
+#include "hashSet.h"
+
+#include <string.h>
+
+void HashSet_clear(HashSet* set)
+{
+  memset(set->used, 0, sizeof(set->used));
+  set->pushedNum = 0;
+}
+
+void HashSet_push(HashSet* set, HashKey key)
+{
+  // Full: only count the push
+  if( set->pushedNum >= HASHSET_KEYS_MAX ){
+    set->pushedNum++;
+    return;
+  }
+
+  short slot = -1;
+  int probe = key & (HASHSET_SIZE-1);
+  while( set->used[probe] && set->keys[probe] != key ){
+    probe = (probe+1) & (HASHSET_SIZE-1);
+  }
+
+  // Only store new keys
+  if( !set->used[probe] ){
+    set->used[probe] = 1;
+    set->keys[probe] = key;
+    slot = probe;
+  }
+
+  set->pushed[set->pushedNum++] = slot;
+}
+
+void HashSet_popTo(HashSet* set, int pushedNum)
+{
+  // Keys pushed later never lie on the probe path of earlier ones,
+  // so they can just be cleared
+  while( set->pushedNum > pushedNum ){
+    if( --set->pushedNum >= HASHSET_KEYS_MAX ) continue;
+    short slot = set->pushed[set->pushedNum];
+    if( slot >= 0 ) set->used[slot] = 0;
+  }
+}
+
+int HashSet_contains(HashSet* set, HashKey key)
+{
+  int probe = key & (HASHSET_SIZE-1);
+  while( set->used[probe] ){
+    if( set->keys[probe] == key ) return 1;
+    probe = (probe+1) & (HASHSET_SIZE-1);
+  }
+  return 0;
+}
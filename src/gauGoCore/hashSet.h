@@ -0,0 +1,84 @@
+/**
+ * @file  hashSet.h
+ * @brief Provides a small open-addressed set of hash keys, with
+ * stack-like (last in, first out) removal.
+ *
+ * The set is meant for the positions of the current game and tree
+ * path: keys are pushed while descending and popped back when the
+ * path is left, which keeps linear probing valid without tombstones.
+ * The set uses no dynamic memory.
+ *
+ **/
+#ifndef HASHSET_H
+#define HASHSET_H
+
+#include "hashTable.h"
+
+/**
+ * @brief Size in bits of the set's table
+ **/
+#define HASHSET_BITS 12
+
+/**
+ * @brief Number of slots of the set's table
+ **/
+#define HASHSET_SIZE (1 << HASHSET_BITS)
+
+/**
+ * @brief Max number of keys in the set (half of the slots, 
+ * to keep probing short).  Keys pushed beyond it are not stored.
+ **/
+#define HASHSET_KEYS_MAX (HASHSET_SIZE / 2)
+
+/**
+ * @brief Open-addressed (linear probing) set of hash keys
+ **/
+typedef struct HashSet
+{
+  /** Slots */
+  HashKey keys[HASHSET_SIZE];
+  unsigned char used[HASHSET_SIZE];
+
+  /** Slot filled by every push, -1 if nothing was stored
+      (pushes beyond HASHSET_KEYS_MAX are only counted) */
+  short pushed[HASHSET_KEYS_MAX];
+  /** Number of pushes not yet popped */
+  int pushedNum;
+
+} HashSet;
+
+/**
+ * @brief Empties the set
+ *
+ * @param set The set
+ **/
+void HashSet_clear(HashSet* set);
+
+/**
+ * @brief Adds a key to the set (keys already in the set are
+ * not added twice, but the push must still be popped)
+ *
+ * @param set The set
+ * @param key The key to add
+ **/
+void HashSet_push(HashSet* set, HashKey key);
+
+/**
+ * @brief Takes back the last pushes, until only the specified
+ * number of pushes is left
+ *
+ * @param set The set
+ * @param pushedNum The number of pushes to keep
+ **/
+void HashSet_popTo(HashSet* set, int pushedNum);
+
+/**
+ * @brief Determines whether a key is in the set
+ *
+ * @param set The set
+ * @param key The key to look for
+ * @return 1 if the key is in the set, 0 otherwise
+ **/
+int HashSet_contains(HashSet* set, HashKey key);
+
+#endif
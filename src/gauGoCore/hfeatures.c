@@ -9,41 +9,49 @@
 
 int simm[] = { 3, 2, 1, 0 };
 
+/**
+ * @brief Determines whether a group is one of the groups put in
+ * atari by the last move
+ **/
+int Features_isNewAtari(Board* board, GRID group)
+{
+  for( int k=0; k<3; k++ ){
+    if( group == board->newAtari[k] ) return 1;
+  }
+  return 0;
+}
+
 int Features_capture(Board* board, INTERSECTION move)
 {
-  int neigh, neighsimm, stone, j;
+  int neigh, neighsimm;
   for( NEIGHBORS(move) ){
     neigh=NEIGHI(board, move);
     neighsimm=NEIGHI_SIMM(board, move);
     int neighgroup = board->groupMap[neigh];
-    
-    if( board->intersectionMap[neigh] == !board->turn ){   
-      
+
+    if( board->intersectionMap[neigh] == !board->turn
+	&& StoneGroup_isAtari(&board->groups[neighgroup]) ){
+
       // Re-capture
-      if( neigh == board->lastMove 
-	  && board->previousWasCapture
-	  && board->groups[neighgroup].libertiesNum == 1 ){
+      if( neigh == board->lastMove
+	  && board->previousWasCapture ){
 	return 2;
       }
-      
+
       // Prevent connection
       if( neigh == board->lastMove
-	  && board->groups[neighgroup].libertiesNum == 1
 	  && board->intersectionMap[neighsimm] == !board->turn ){
 	return 3;
       }
 
       // Contiguous to new-atari friend string
-      if( board->groups[neighgroup].libertiesNum == 1 ){
-	for( STONES(board, board->groupMap[neighgroup]) ){
-	  for( NEIGHBORS2(move, j) ){
-	    int neigh2 = NEIGHI2(board, move, j);
-	    
-	    for( int k=0; k<3; k++ ){
-	      if( board->groupMap[neigh2] == board->newAtari[k] ){
-		return 1;
-	      }
-	    }
+      for( STONES(board, neighgroup) ){
+	INTERSECTION stone = STONEI();
+	for( NEIGHBORS2(stone, j) ){
+	  int neigh2 = NEIGHI2(board, stone, j);
+	  if( board->intersectionMap[neigh2] == board->turn
+	      && Features_isNewAtari(board, board->groupMap[neigh2]) ){
+	    return 1;
 	  }
 	}
       }
@@ -60,14 +68,11 @@ int Features_extension(Board* board, INTERSECTION move)
   for( NEIGHBORS(move) ){
     neigh=NEIGHI(board, move);
     int neighgroup = board->groupMap[neigh];
-    
-    if( board->intersectionMap[neigh] == !board->turn ){
-      if( board->groups[neighgroup].libertiesNum == 1 ){
-	for( int j=0; j<3; j++ ){
-	  if( neighgroup == board->newAtari[j] ) 
-	    return 1;
-	}
-      }
+
+    if( board->intersectionMap[neigh] == board->turn
+	&& StoneGroup_isAtari(&board->groups[neighgroup])
+	&& Features_isNewAtari(board, neighgroup) ){
+      return 1;
     }
   }
 
@@ -76,17 +81,24 @@ int Features_extension(Board* board, INTERSECTION move)
 
 int Features_selfAtari(Board* board, INTERSECTION move)
 {
-  int neigh, newLibs=0, friendsLibs=0;
+  BoardUndo undo;
+  Board_quickPlay(board, move, board->turn, &undo);
+
+  // Captures give liberties: not self-atari
+  int neigh, capture = 0;
   for( NEIGHBORS(move) ){
     neigh=NEIGHI(board, move);
-    if( board->intersectionMap[neigh] == EMPTY ) newLibs++;
-    else if( board->intersectionMap[neigh] == board->turn ){   
-      int neighgroup = board->groupMap[neigh];
-      friendsLibs += board->groups[neighgroup].libertiesNum;
+    if( board->intersectionMap[neigh] == !board->turn
+	&& board->groups[board->groupMap[neigh]].libertiesNum == 0 ){
+      capture = 1;
     }
   }
 
-  return (friendsLibs-1) > newLibs;
+  int selfAtari = !capture
+    && Board_libertiesNum(board, board->groupMap[move]) <= 1;
+
+  Board_undoQuickPlay(board, &undo);
+  return selfAtari;
 }
 
 int Features_atari(Board* board, INTERSECTION move)
@@ -94,9 +106,9 @@ int Features_atari(Board* board, INTERSECTION move)
   int neigh;
   for( NEIGHBORS(move) ){
     neigh=NEIGHI(board, move);
-    if( board->intersectionMap[neigh] == !board->turn 
-	&& board->groups[board->groupMap[neigh]].libertiesNum == 2){
-      return 1;
+    if( board->intersectionMap[neigh] == !board->turn
+	&& Board_libertiesNum(board, board->groupMap[neigh]) == 2){
+      return board->koPosition != -1 ? 1 : 2;
     }
   }
 
@@ -105,9 +117,11 @@ int Features_atari(Board* board, INTERSECTION move)
 
 int Features_distancePrevious(Board* board, INTERSECTION move)
 {
-  int dx = Board_intersectionX(board, move) 
+  if( board->lastMove == PASS || board->lastMove == 0 ) return 0;
+
+  int dx = Board_intersectionX(board, move)
     - Board_intersectionX(board, board->lastMove);
-  int dy = Board_intersectionY(board, move) 
+  int dy = Board_intersectionY(board, move)
     - Board_intersectionY(board, board->lastMove);
 
   int dist = abs(dx)+abs(dy)+MAX(abs(dx), abs(dy));
@@ -5,9 +5,24 @@
  **/
 
 #include <getopt.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "options.h"
 
+PolicyId Options_policyId( const char* name )
+{
+  if( strcmp(name, "patterns") == 0 ) return POLICY_ID_PATTERNS3x3;
+  if( strcmp(name, "mogo") == 0 ) return POLICY_ID_MOGO;
+  if( strcmp(name, "random") == 0 ) return POLICY_ID_PURERANDOM;
+  return POLICY_ID_UNKNOWN;
+}
+
+int Options_mercyThreshold( Options* options, int boardSize )
+{
+  return boardSize * boardSize * options->mercy / 100;
+}
+
 void Options_initialize( Options* options, int argc, char** argv )
 { 
   // First set all defaults
@@ -18,6 +33,15 @@ void Options_initialize( Options* options, int argc, char** argv )
   options->verbosity = 1;
   options->expansionVisits = 7;
   options->gogui = 0;
+  options->scoringPlayouts = 1000;
+  options->seed = 0;
+  options->policy = POLICY_ID_PURERANDOM;
+  options->patternWeightsFile = NULL;
+  options->mercy = 20;
+  options->priorVisits = 10;
+  options->wideningChildren = 10;
+  options->wideningGrowth = 1.3f;
+  options->serverWorkers = 0;
 
   // Parse command line options
   static struct option long_options[] = {
@@ -28,13 +52,24 @@ void Options_initialize( Options* options, int argc, char** argv )
     {"verbosity", required_argument, 0, 'v'},
     {"expansion_visits", required_argument, 0, 'x'},
     {"gogui", no_argument, 0, 'g'},
+    {"scoring_playouts", required_argument, 0, 'c'},
+    {"seed", required_argument, 0, 'r'},
+    {"policy", required_argument, 0, 'y'},
+    {"pattern_weights", required_argument, 0, 'w'},
+    {"mercy", required_argument, 0, 'm'},
+    {"prior_visits", required_argument, 0, 'n'},
+    {"widening_children", required_argument, 0, 'a'},
+    {"widening_growth", required_argument, 0, 'b'},
+    {"server", required_argument, 0, 'j'},
     //{"datapath", required_argument, 0,  'd' },
     {0,         0,                 0,  0 }
   };
   int c, option_index;
-  
+
+  // Parse from the start, options may be parsed more than once
+  optind = 0;
   while(1){
-    c = getopt_long(argc, argv, "s:h:k:p:v:x:g:", long_options, &option_index);
+    c = getopt_long(argc, argv, "s:h:k:p:v:x:g:c:r:y:w:m:n:a:b:j:", long_options, &option_index);
     if( c==-1 ) break;
     switch(c){
       // Board size
@@ -44,13 +79,36 @@ void Options_initialize( Options* options, int argc, char** argv )
       // Nodes in one pool in tree
     case 'p' : options->treePoolNodeNum = atoi(optarg); break;
       // Komi
-    case 'k' : options->boardSize = atof(optarg); break;
+    case 'k' : options->komi = atof(optarg); break;
       // Verbosity
     case 'v' : options->verbosity = atoi(optarg); break;
       // Expansion visits threashold
     case 'x' : options->expansionVisits = atoi(optarg); break;
       // Gogui output mode
     case 'g': options->gogui = 1; break;
+      // Playouts for dead stones estimation
+    case 'c': options->scoringPlayouts = atoi(optarg); break;
+      // Random seed
+    case 'r': options->seed = strtoull(optarg, NULL, 0); break;
+      // Playout policy
+    case 'y':
+      options->policy = Options_policyId(optarg);
+      if( options->policy == POLICY_ID_UNKNOWN ){
+	fprintf( stderr, "Unknown playout policy: %s\n", optarg );
+	exit( 1 );
+      }
+      break;
+      // Pattern weights
+    case 'w': options->patternWeightsFile = optarg; break;
+      // Mercy rule
+    case 'm': options->mercy = atoi(optarg); break;
+      // Prior knowledge
+    case 'n': options->priorVisits = atoi(optarg); break;
+      // Progressive widening
+    case 'a': options->wideningChildren = atoi(optarg); break;
+    case 'b': options->wideningGrowth = atof(optarg); break;
+      // Multi-game server
+    case 'j': options->serverWorkers = atoi(optarg); break;
     }
   }
 }
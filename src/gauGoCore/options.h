@@ -6,6 +6,16 @@
 #ifndef OPTIONS_H
 #define OPTIONS_H
 
+/**
+ * @brief Playout policies that can be selected
+ **/
+typedef enum {
+  POLICY_ID_PURERANDOM,
+  POLICY_ID_PATTERNS3x3,
+  POLICY_ID_MOGO,
+  POLICY_ID_UNKNOWN
+} PolicyId;
+
 
 /**
  * @brief GauGo program options
@@ -34,9 +44,59 @@ typedef struct Options
   /** Gogui extension output */
   int gogui;
 
+  /** Number of playouts used to estimate dead stones when scoring */
+  int scoringPlayouts;
+
+  /** Random seed (0: seeded from current time) */
+  unsigned long long seed;
+
+  /** Playout policy */
+  PolicyId policy;
+
+  /** 3x3 pattern weights file for the patterns policy (NULL: defaults) */
+  char* patternWeightsFile;
+
+  /** Playouts stop when a player has gained this many stones on
+      the other since the playout started, in percent of the board
+      intersections (0: never) */
+  int mercy;
+
+  /** Virtual playouts of one prior knowledge heuristic for new tree
+      nodes (0: no prior knowledge) */
+  int priorVisits;
+
+  /** Progressive widening: children of a tree node that can be 
+      selected at first, best prior first (0: all of them) */
+  int wideningChildren;
+
+  /** Progressive widening: one more child can be selected every 
+      time the node's playouts are multiplied by this factor (> 1) */
+  float wideningGrowth;
+
+  /** Server mode: worker threads playing the hosted games 
+      (0: single game GTP engine) */
+  int serverWorkers;
+
 } Options;
 
 
 void Options_initialize( Options* options, int argc, char** argv );
 
+/**
+ * @brief Obtains a playout policy from its name
+ *
+ * @param name "random", "patterns" or "mogo"
+ * @return The policy, or POLICY_ID_UNKNOWN for other names
+ **/
+PolicyId Options_policyId( const char* name );
+
+/**
+ * @brief Obtains the mercy rule threshold for a board size
+ *
+ * @param options The options
+ * @param boardSize The board size
+ * @return The stones difference that ends a playout (0: never)
+ **/
+int Options_mercyThreshold( Options* options, int boardSize );
+
 #endif
@@ -0,0 +1,136 @@
+/**
+ * @file  policies.c
+ * @brief Playout policy interface implementation
+ *
+ **/
+
+#include <string.h>
+#include "policies.h"
+
+int Policy_initialize( Policy* policy, PolicyId id )
+{
+  memset(policy, 0, sizeof(Policy));
+
+  switch( id ){
+  case POLICY_ID_PATTERNS3x3: return POLICY_patterns3x3Initialize(policy);
+  case POLICY_ID_MOGO: POLICY_mogoInitialize(policy); break;
+  default: policy->playout = &POLICY_pureRandom; break;
+  }
+  return 1;
+}
+
+void Policy_teardown( Policy* policy )
+{
+  if( policy->teardown ) policy->teardown(policy);
+  policy->ctx = NULL;
+}
+
+void Policy_start( Policy* policy, Board* board )
+{
+  // A position already won by many stones is not decided yet
+  policy->mercyBase = board->stonesDiff;
+}
+
+Color Policy_mercyWinner( Policy* policy, Board* board )
+{
+  if( !policy->mercyThreshold ) return EMPTY;
+
+  int gained = board->stonesDiff - policy->mercyBase;
+  if( gained >= policy->mercyThreshold ) return BLACK;
+  if( -gained >= policy->mercyThreshold ) return WHITE;
+  return EMPTY;
+}
+
+void PlayoutStats_clear( PlayoutStats* stats )
+{
+  memset(stats, 0, sizeof(PlayoutStats));
+}
+
+void PlayoutStats_add( PlayoutStats* stats, Board* board, BoardIterator* it,
+		       Color winner, int finished, unsigned char* playedMoves )
+{
+  stats->playouts++;
+  if( winner == BLACK ) stats->blackWins++;
+  if( finished ){
+    stats->finished++;
+    if( winner == BLACK ) stats->finishedBlackWins++;
+  }
+  // Nothing else to count
+  else if( !playedMoves ) return;
+
+  INTERSECTION intersection;
+  for( INTERSECTIONS(it) ){
+    intersection = INTERSECTIONI(it);
+
+    // Ownership, only meaningful on finished boards
+    if( finished ){
+      Color owner = Board_trompTaylorOwner(board, intersection);
+      stats->owned[owner][intersection]++;
+      if( owner == winner ) stats->ownedByWinner[intersection]++;
+    }
+
+    // AMAF, clearing played moves for the next playout
+    if( !playedMoves || !playedMoves[intersection] ) continue;
+    for( Color color=BLACK; color<=WHITE; color++ ){
+      if( playedMoves[intersection] & (color+1) ){
+	stats->amafPlayed[color][intersection]++;
+	if( winner == color ) stats->amafWins[color][intersection]++;
+      }
+    }
+    playedMoves[intersection] = 0;
+  }
+}
+
+float PlayoutStats_ownership( PlayoutStats* stats, INTERSECTION intersection )
+{
+  if( !stats->finished ) return 0.0f;
+  return (float)(stats->owned[BLACK][intersection] 
+		 - stats->owned[WHITE][intersection]) / stats->finished;
+}
+
+float PlayoutStats_criticality( PlayoutStats* stats, INTERSECTION intersection )
+{
+  if( !stats->finished ) return 0.0f;
+
+  float n = stats->finished;
+  float blackWins = stats->finishedBlackWins / n;
+  float black = stats->owned[BLACK][intersection] / n;
+  float white = stats->owned[WHITE][intersection] / n;
+
+  // Owned by the winner, minus what independence would give
+  return stats->ownedByWinner[intersection] / n
+    - (black * blackWins + white * (1.0f - blackWins));
+}
+
+void Policy_playouts( Policy* policy, Board* board, float komi, 
+		      int playouts, PlayoutStats* stats )
+{
+  BoardIterator it;
+  Board_iterator(board, &it);
+
+  Board playout;
+  unsigned char playedMoves[MAX_INTERSECTION_NUM];
+  memset(playedMoves, 0, sizeof(playedMoves));
+
+  for( int p=0; p<playouts; p++ ){
+    Board_copy(&playout, board);
+    Color winner = policy->playout(policy, &playout, &it, komi, playedMoves);
+    PlayoutStats_add(stats, &playout, &it, winner, policy->finished,
+		     playedMoves);
+  }
+}
+
+Color Policy_finish( Policy* policy, Board* board, BoardIterator* it,
+		     float komi, int moves )
+{
+  policy->playouts++;
+  policy->moves += moves;
+
+  // Stopped by the mercy rule
+  Color winner = Policy_mercyWinner( policy, board );
+  policy->finished = winner == EMPTY;
+  if( winner != EMPTY ) return winner;
+
+  int score = Board_trompTaylorScore( board, it );
+  return (score > komi) ? BLACK : WHITE;
+}
@@ -1,21 +1,287 @@
 /**
  * @file  policies.h
- * @brief Some standard playout policies
+ * @brief Playout policy interface, and some standard playout policies
+ *
+ * A policy transforms an arbitrary go board into a finished game
+ * (i.e. performs a playout) and tells the winner.  Every policy
+ * instance has its own context, set up by Policy_initialize and
+ * freed by Policy_teardown, so that heavier policies can keep data
+ * across playouts.  A policy instance must not be shared by threads.
  *
  **/
 #ifndef POLICIES_H
 #define POLICIES_H
 
 #include "board.h"
+#include "options.h"
+
+/**
+ * @brief A playout policy instance
+ **/
+typedef struct Policy
+{
+  /**
+   * Performs a playout on the board and returns the winner.
+   * Moves played are marked in playedMoves (1 for black, 2 for
+   * white, or both).
+   **/
+  Color (*playout)(struct Policy* policy, Board* board, BoardIterator* it,
+		   float komi, unsigned char* playedMoves);
+
+  /**
+   * Frees the context (NULL if there is nothing to free)
+   **/
+  void (*teardown)(struct Policy* policy);
+
+  /**
+   * Policy specific data, kept across playouts
+   **/
+  void* ctx;
+
+  /**
+   * Mercy rule: a playout stops as soon as a player has gained this
+   * many stones on the other since the playout started, and wins
+   * (0: disabled)
+   **/
+  int mercyThreshold;
+
+  /**
+   * Stones difference (black - white) at the start of the current
+   * playout, the mercy rule counts from it
+   **/
+  int mercyBase;
+
+  /**
+   * Whether the last playout was played to the end (0: stopped by
+   * the mercy rule, its final position says nothing of ownership)
+   **/
+  int finished;
+
+  /**
+   * Statistics: playouts done and moves played in all of them
+   **/
+  unsigned long long playouts;
+  unsigned long long moves;
+
+} Policy;
+
+/**
+ * @brief Aggregated results of playouts run from the same position
+ **/
+typedef struct PlayoutStats
+{
+  /**
+   * Number of playouts, and how many of them black won
+   **/
+  int playouts;
+  int blackWins;
+
+  /**
+   * Playouts played to the end, from which ownership is counted,
+   * and how many of them black won
+   **/
+  int finished;
+  int finishedBlackWins;
+
+  /**
+   * For every color and intersection, the number of finished
+   * playouts in which the intersection ended owned by the color
+   **/
+  int owned[2][MAX_INTERSECTION_NUM];
+
+  /**
+   * For every intersection, the number of finished playouts in
+   * which it ended owned by the winner
+   **/
+  int ownedByWinner[MAX_INTERSECTION_NUM];
+
+  /**
+   * All moves as first (AMAF): for every color and intersection, 
+   * the number of playouts in which the color played there, and 
+   * how many of them the color won
+   **/
+  int amafPlayed[2][MAX_INTERSECTION_NUM];
+  int amafWins[2][MAX_INTERSECTION_NUM];
+
+} PlayoutStats;
+
+/**
+ * @brief Sets up a policy instance
+ *
+ * @param policy The policy instance
+ * @param id Which policy
+ * @return 1 on success, 0 if out of memory
+ **/
+int Policy_initialize( Policy* policy, PolicyId id );
+
+/**
+ * @brief Frees everything allocated by a policy instance
+ *
+ * @param policy The policy instance
+ **/
+void Policy_teardown( Policy* policy );
+
+/**
+ * @brief Starts a playout, to be called by policies before the
+ * first move
+ *
+ * @param policy The policy instance
+ * @param board The playout board
+ **/
+void Policy_start( Policy* policy, Board* board );
+
+/**
+ * @brief Checks the mercy rule, to be called by policies after
+ * every move
+ *
+ * @param policy The policy instance
+ * @param board The playout board
+ * @return The winner if the playout can stop, EMPTY otherwise
+ **/
+Color Policy_mercyWinner( Policy* policy, Board* board );
+
+/**
+ * @brief Ends a playout: updates the statistics and computes the
+ * winner (with the mercy rule, or with tromp-taylor rules)
+ *
+ * @param policy The policy instance
+ * @param board The playout board
+ * @param it An iterator on the board
+ * @param komi Komi
+ * @param moves Number of moves played in the playout (passes included)
+ * @return The winner
+ **/
+Color Policy_finish( Policy* policy, Board* board, BoardIterator* it,
+		     float komi, int moves );
+
+/**
+ * @brief Sets all the statistics to 0
+ *
+ * @param stats The statistics
+ **/
+void PlayoutStats_clear( PlayoutStats* stats );
+
+/**
+ * @brief Adds the result of a playout to the statistics, in one
+ * pass over the board.  Ownership is only counted for playouts
+ * played to the end.
+ *
+ * @param stats The statistics
+ * @param board The board at the end of the playout
+ * @param it An iterator on the board
+ * @param winner The winner of the playout
+ * @param finished Whether the playout was played to the end
+ * (see Policy::finished)
+ * @param playedMoves Moves played in the playout, as marked by the
+ * policy, for AMAF statistics (NULL: no AMAF).  It is cleared for
+ * the next playout.
+ **/
+void PlayoutStats_add( PlayoutStats* stats, Board* board, BoardIterator* it,
+		       Color winner, int finished, unsigned char* playedMoves );
+
+/**
+ * @brief Obtains the Monte-Carlo ownership of an intersection, over
+ * the finished playouts
+ *
+ * @param stats The statistics
+ * @param intersection The intersection
+ * @return From 1 (always black's) to -1 (always white's)
+ **/
+float PlayoutStats_ownership( PlayoutStats* stats, INTERSECTION intersection );
+
+/**
+ * @brief Obtains the criticality of an intersection: twice the 
+ * covariance between black owning it and black winning, over the 
+ * finished playouts.  Intersections whose owner decides the game are
+ * close to 0.5 (when both colors win as often), those with no 
+ * influence on the result close to 0.
+ *
+ * @param stats The statistics
+ * @param intersection The intersection
+ * @return The criticality, from -0.5 to 0.5
+ **/
+float PlayoutStats_criticality( PlayoutStats* stats, INTERSECTION intersection );
+
+/**
+ * @brief Runs playouts from the same position, and adds their
+ * results to the statistics.  The board is copied for every 
+ * playout, everything else is set up once.
+ *
+ * @param policy The policy instance
+ * @param board The position (left unchanged)
+ * @param komi Komi
+ * @param playouts The number of playouts
+ * @param stats The statistics to update
+ **/
+void Policy_playouts( Policy* policy, Board* board, float komi, 
+		      int playouts, PlayoutStats* stats );
 
 /**
  * @brief Pure random playout policy.
- * Non-suicide legal moves are randomly selected until 
+ * Non-suicide legal moves are randomly selected until
  * no moves are left on the board.
- * Scores are then calculated using tromp-taylor rules, 
+ * Scores are then calculated using tromp-taylor rules,
  * and the winner is returned.
  **/
-Color POLICY_pureRandom( Board* board, BoardIterator* it, 
+Color POLICY_pureRandom( Policy* policy, Board* board, BoardIterator* it,
 			 float komi, unsigned char* playedMoves );
 
+/**
+ * @brief 3x3 patterns playout policy.
+ * Non-suicide legal moves are selected with probability proportional
+ * to the weight of their 3x3 pattern (atari bits included), until
+ * no moves are left on the board.
+ * Scores are then calculated using tromp-taylor rules,
+ * and the winner is returned.
+ **/
+Color POLICY_patterns3x3( Policy* policy, Board* board, BoardIterator* it,
+			  float komi, unsigned char* playedMoves );
+
+/**
+ * @brief Sets up the context of a 3x3 patterns policy instance
+ *
+ * @param policy The policy instance
+ * @return 1 on success, 0 if out of memory
+ **/
+int POLICY_patterns3x3Initialize( Policy* policy );
+
+/**
+ * @brief Loads 3x3 pattern weights for POLICY_patterns3x3 from a text
+ * file, one "pattern weight" pair per line (pattern in hexadecimal,
+ * for black to play, weight from 0 to 65535).  Patterns not in
+ * the file keep their default weight.
+ *
+ * @param fileName The file name
+ * @return 1 on success, 0 if the file could not be opened
+ **/
+int POLICY_patterns3x3LoadWeights( const char* fileName );
+
+/**
+ * @brief Mogo-like sequential playout policy.
+ * Looks for answers to ataris made by the last move, then for
+ * captures around it, then for Mogo 3x3 patterns around it, and
+ * falls back to a random move when there is nothing local to play.
+ * Scores are then calculated using tromp-taylor rules,
+ * and the winner is returned.
+ **/
+Color POLICY_mogo( Policy* policy, Board* board, BoardIterator* it,
+		   float komi, unsigned char* playedMoves );
+
+/**
+ * @brief Sets up a Mogo-like policy instance
+ *
+ * @param policy The policy instance
+ **/
+void POLICY_mogoInitialize( Policy* policy );
+
+/**
+ * @brief Determines if a move matches one of the Mogo 3x3 patterns
+ * used by the Mogo-like policy, for current turn's player
+ *
+ * @param board The board
+ * @param move An empty intersection
+ * @return 1 if it matches, 0 otherwise
+ **/
+int POLICY_mogoPattern( Board* board, INTERSECTION move );
+
 #endif
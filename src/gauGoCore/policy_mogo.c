@@ -0,0 +1,283 @@
+/**
+ * @file  policy_mogo.c
+ * @brief Mogo-like sequential playout policy implementation
+ *
+ * Moves are chosen by the first rule that gives any candidate:
+ * 1. Answer an atari made by the last move (capture or extend)
+ * 2. Capture a group next to the last move
+ * 3. Play a Mogo 3x3 pattern around the last move
+ * 4. Random
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "policies.h"
+#include "hfeatures.h"
+
+/**
+ * @brief Mogo's 3x3 patterns (Gelly et al. 2006, as listed in Pachi),
+ * for X to play on the center.
+ * X: own stone, O: opponent stone, .: empty, #: border,
+ * x: not own stone, o: not opponent stone, ?: anything
+ **/
+const char* mogoPatternsSource[] = {
+  "XOX" "..." "???",   // hane: enclosing hane
+  "XO." "..." "?.?",   // hane: non-cutting hane
+  "XO?" "X.." "x.?",   // hane: magari
+  "XOO" "..." "?.?",   // hane: thin hane
+  ".O." "X.." "...",   // katatsuke or diagonal attachment
+  "XO?" "O.o" "?o?",   // cut1: unprotected cut
+  "XO?" "O.X" "???",   // cut1: peeped cut
+  "?X?" "O.O" "ooo",   // cut2
+  "OX?" "o.O" "???",   // cut keima
+  "X.?" "O.?" "##?",   // side: chase
+  "OX?" "X.O" "###",   // side: block side cut
+  "?X?" "x.O" "###",   // side: block side connection
+  NULL
+};
+
+/** Whether a 16 bits pattern (black to play) is a Mogo pattern */
+unsigned char mogoPatterns[1<<16];
+int mogoPatternsInitialized = 0;
+
+/** Pattern direction (see Board directionOffsets) of every cell
+    of a 3x3 source, row by row (-1 for the center) */
+const int mogoCellDirections[9] = { 0, 1, 2, 3, -1, 4, 5, 6, 7 };
+
+/**
+ * @brief Determines if a cell value (00 empty, 01 border, 10 black,
+ * 11 white) matches a pattern source character, for black to play
+ **/
+int mogo_cellMatches(char c, int value)
+{
+  switch( c ){
+  case 'X': return value == 2;
+  case 'O': return value == 3;
+  case '.': return value == 0;
+  case '#': return value == 1;
+  case 'x': return value != 2;
+  case 'o': return value != 3;
+  default: return 1;
+  }
+}
+
+/**
+ * @brief Fills the Mogo patterns table, trying all 8 symmetries
+ * of every source pattern on every 3x3 configuration
+ **/
+void mogo_initializePatterns()
+{
+  memset(mogoPatterns, 0, sizeof(mogoPatterns));
+
+  for( int s=0; mogoPatternsSource[s]; s++ ){
+    const char* source = mogoPatternsSource[s];
+
+    for( int sym=0; sym<8; sym++ ){
+      // Cell of the source that lands on every cell of the board
+      int map[9];
+      for( int r=0; r<3; r++ ){
+	for( int c=0; c<3; c++ ){
+	  int sr = r, sc = c, t;
+	  if( sym & 1 ) sc = 2-sc;
+	  if( sym & 2 ) sr = 2-sr;
+	  if( sym & 4 ){ t = sr; sr = sc; sc = t; }
+	  map[r*3+c] = sr*3+sc;
+	}
+      }
+
+      for( int p=0; p<(1<<16); p++ ){
+	int matches = 1;
+	for( int cell=0; cell<9 && matches; cell++ ){
+	  int dir = mogoCellDirections[cell];
+	  if( dir < 0 ) continue;
+	  int value = (p >> ((7-dir)*2)) & 3;
+	  matches = mogo_cellMatches(source[map[cell]], value);
+	}
+	if( matches ) mogoPatterns[p] = 1;
+      }
+    }
+  }
+
+  mogoPatternsInitialized = 1;
+}
+
+/**
+ * @brief Determines if the move matches a Mogo pattern for
+ * current turn's player
+ **/
+int mogo_isPattern(Board* board, INTERSECTION move)
+{
+  int pattern = board->patterns3x3[move] & 0xFFFF;
+  if( board->turn == WHITE ) pattern ^= (pattern >> 1) & 0x5555;
+  return mogoPatterns[pattern];
+}
+
+int POLICY_mogoPattern(Board* board, INTERSECTION move)
+{
+  if( !mogoPatternsInitialized ) mogo_initializePatterns();
+  return mogo_isPattern(board, move);
+}
+
+/**
+ * @brief Adds a move to a candidates list if legal and not yet in it
+ **/
+void mogo_addCandidate(Board* board, INTERSECTION* candidates, int* num,
+		       INTERSECTION move)
+{
+  if( !Board_isLegalNoEyeFilling(board, move) ) return;
+  for( int c=0; c<*num; c++ ){
+    if( candidates[c] == move ) return;
+  }
+  candidates[(*num)++] = move;
+}
+
+/**
+ * @brief Rule 1: captures and extensions saving the groups put in
+ * atari by the last move
+ **/
+int mogo_answerAtari(Board* board, INTERSECTION* candidates)
+{
+  int num = 0;
+
+  for( int a=0; a<3; a++ ){
+    GRID group = board->newAtari[a];
+    if( group == NULL_GROUP ) continue;
+    // Might have been captured and replaced since
+    if( board->intersectionMap[group] != board->turn
+	|| !StoneGroup_isAtari(&board->groups[group]) ) continue;
+
+    // Capture a neighbor group in atari
+    int neigh;
+    for( STONES(board, group) ){
+      INTERSECTION stone = STONEI();
+      for( NEIGHBORS(stone) ){
+	neigh = NEIGHI(board, stone);
+	if( board->intersectionMap[neigh] != !board->turn ) continue;
+	StoneGroup* neighGroup = &board->groups[board->groupMap[neigh]];
+	if( !StoneGroup_isAtari(neighGroup) ) continue;
+
+	INTERSECTION capture = StoneGroup_atariLiberty(neighGroup);
+	if( Features_capture(board, capture) ){
+	  mogo_addCandidate(board, candidates, &num, capture);
+	}
+      }
+    }
+
+    // Extend, unless it only runs into a ladder
+    INTERSECTION extension = StoneGroup_atariLiberty(&board->groups[group]);
+    if( Features_extension(board, extension)
+	&& !Board_ladderCapturable(board, group) ){
+      mogo_addCandidate(board, candidates, &num, extension);
+    }
+  }
+
+  return num;
+}
+
+/**
+ * @brief Rule 2: captures of groups around the last move
+ **/
+int mogo_captureNearLast(Board* board, INTERSECTION* candidates)
+{
+  int num = 0;
+  INTERSECTION last = board->lastMove;
+
+  int neigh;
+  for( NEIGHBORS_DIAG(last) ){
+    neigh = NEIGHI_DIAG(board, last);
+    if( board->intersectionMap[neigh] != !board->turn ) continue;
+    StoneGroup* group = &board->groups[board->groupMap[neigh]];
+    if( StoneGroup_isAtari(group) ){
+      mogo_addCandidate(board, candidates, &num,
+			StoneGroup_atariLiberty(group));
+    }
+  }
+
+  // The last stone itself
+  if( StoneGroup_isAtari(&board->groups[board->groupMap[last]]) ){
+    mogo_addCandidate(board, candidates, &num,
+		      StoneGroup_atariLiberty(&board->groups[board->groupMap[last]]));
+  }
+
+  return num;
+}
+
+/**
+ * @brief Rule 3: Mogo patterns around the last move, self-ataris excluded
+ **/
+int mogo_patternNearLast(Board* board, INTERSECTION* candidates)
+{
+  int num = 0;
+  INTERSECTION last = board->lastMove;
+
+  int neigh;
+  for( NEIGHBORS_DIAG(last) ){
+    neigh = NEIGHI_DIAG(board, last);
+    if( board->intersectionMap[neigh] != EMPTY ) continue;
+    if( mogo_isPattern(board, neigh)
+	&& Board_isLegalNoEyeFilling(board, neigh)
+	&& !Features_selfAtari(board, neigh) ){
+      candidates[num++] = neigh;
+    }
+  }
+
+  return num;
+}
+
+/**
+ * @brief Chooses the move to play
+ **/
+INTERSECTION mogo_chooseMove(Board* board)
+{
+  INTERSECTION candidates[32];
+  int num = 0;
+
+  // Local rules only make sense after a move on the board
+  INTERSECTION last = board->lastMove;
+  if( last != PASS && last != 0 && board->intersectionMap[last] <= WHITE ){
+    num = mogo_answerAtari(board, candidates);
+    if( !num ) num = mogo_captureNearLast(board, candidates);
+    if( !num ) num = mogo_patternNearLast(board, candidates);
+  }
+
+  if( num ) return candidates[Rng_range(&threadRng, num)];
+  return Board_randomPlayable(board, &threadRng);
+}
+
+void POLICY_mogoInitialize( Policy* policy )
+{
+  if( !mogoPatternsInitialized ) mogo_initializePatterns();
+
+  policy->playout = &POLICY_mogo;
+}
+
+Color POLICY_mogo( Policy* policy, Board* board, BoardIterator* iter,
+		   float komi, unsigned char* playedMoves )
+{
+  Policy_start( policy, board );
+
+  int passed = 0, moves = 0;
+  while( moves < PLAYOUT_MOVES_MAX ){
+    INTERSECTION move = mogo_chooseMove(board);
+    moves++;
+
+    if( move == PASS ){
+      if( passed ) break;
+      passed = 1;
+      Board_pass(board);
+      continue;
+    }
+    passed = 0;
+    Board_play(board, move);
+
+    // Mark the move as played
+    playedMoves[move] |= (!board->turn)+1;
+
+    if( Policy_mercyWinner(policy, board) != EMPTY ) break;
+  }
+
+  // Endgame!
+  return Policy_finish( policy, board, iter, komi, moves );
+}
@@ -0,0 +1,254 @@
+/**
+ * @file  policy_patterns3x3.c
+ * @brief 3x3 patterns playout policy implementation
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "policies.h"
+#include "sampler.h"
+
+/**
+ * @brief Number of 3x3 patterns (atari bits included)
+ **/
+#define PATTERNS3x3_NUM (1<<20)
+
+/**
+ * @brief Swaps black and white stones in a 3x3 pattern
+ * (10 <-> 11, empty and border are left as they are)
+ **/
+#define PATTERN_SWAP_COLORS(p) ((p) ^ (((p) >> 1) & 0x5555))
+
+/** Weights of the patterns, for black to play */
+unsigned short patternWeights[PATTERNS3x3_NUM];
+int patternWeightsInitialized = 0;
+
+/**
+ * @brief State of a playout: weights of all playable moves of both
+ * colors, and intersections whose pattern changed since the weights
+ * were last updated (collected by the board's pattern hook)
+ **/
+typedef struct PatternsPlayout
+{
+  Sampler samplers[2];
+  INTERSECTION dirty[MAX_INTERSECTION_NUM];
+  unsigned char dirtyMap[MAX_INTERSECTION_NUM];
+  int dirtyNum;
+
+} PatternsPlayout;
+
+/**
+ * @brief Computes the default weight of a pattern, for black to play,
+ * from some simple go knowledge
+ **/
+unsigned short patterns3x3_defaultWeight(int pattern)
+{
+  int stones = 0, borders = 0;
+  for( int j=0; j<8; j++ ){
+    int value = (pattern >> ((7-j)*2)) & 3;
+    if( value >= 2 ) stones++;
+    else if( value == 1 ) borders++;
+  }
+
+  // Far from everything: low, even lower on the edge
+  int weight = borders ? 20 : 40;
+
+  // Contact moves
+  if( stones ) weight = 100 + 20*stones;
+
+  // Orthogonal neighbors in atari (N, W, E, S)
+  const int orth[4] = {1, 3, 4, 6};
+  for( int k=0; k<4; k++ ){
+    if( !((pattern >> (19-k)) & 1) ) continue;
+    int value = (pattern >> ((7-orth[k])*2)) & 3;
+
+    // Capture
+    if( value == 3 ) weight += 2000;
+    // Save own group
+    else if( value == 2 ) weight += 400;
+  }
+
+  return weight;
+}
+
+/**
+ * @brief Fills the pattern weights with default values
+ **/
+void patterns3x3_initializeWeights()
+{
+  for( int p=0; p<PATTERNS3x3_NUM; p++ ){
+    patternWeights[p] = patterns3x3_defaultWeight(p);
+  }
+  patternWeightsInitialized = 1;
+}
+
+int POLICY_patterns3x3LoadWeights( const char* fileName )
+{
+  FILE* file = fopen(fileName, "r");
+  if( !file ) return 0;
+
+  if( !patternWeightsInitialized ) patterns3x3_initializeWeights();
+
+  // One "pattern weight" pair per line, pattern in hex
+  unsigned int pattern, weight;
+  while( fscanf(file, "%x %u", &pattern, &weight) == 2 ){
+    if( pattern < PATTERNS3x3_NUM ){
+      patternWeights[pattern] = weight > 0xFFFF ? 0xFFFF : weight;
+    }
+  }
+
+  fclose(file);
+  return 1;
+}
+
+/**
+ * @brief Obtains the current weight of an intersection for a color
+ **/
+unsigned int patterns3x3_weight( Board* board, INTERSECTION intersection,
+				 Color color )
+{
+  if( !(Board_playableColors(board, intersection) & (color+1)) ) return 0;
+  if( color == board->turn && intersection == board->koPosition ) return 0;
+
+  int pattern = board->patterns3x3[intersection];
+  if( color == WHITE ) pattern = PATTERN_SWAP_COLORS(pattern);
+  return patternWeights[pattern];
+}
+
+/**
+ * @brief Updates the weights of an intersection for both colors
+ **/
+void patterns3x3_update( PatternsPlayout* playout, Board* board,
+			 INTERSECTION intersection )
+{
+  for( Color color=BLACK; color<=WHITE; color++ ){
+    Sampler_set(&playout->samplers[color], intersection,
+		patterns3x3_weight(board, intersection, color));
+  }
+}
+
+/**
+ * @brief Board pattern hook: remembers the intersection, its weights
+ * are updated once the move is complete
+ **/
+void patterns3x3_patternChanged( void* ctx, INTERSECTION intersection )
+{
+  PatternsPlayout* playout = (PatternsPlayout*)ctx;
+  if( playout->dirtyMap[intersection] ) return;
+  playout->dirtyMap[intersection] = 1;
+  playout->dirty[playout->dirtyNum++] = intersection;
+}
+
+/**
+ * @brief Updates the weights of all intersections whose pattern
+ * changed with the last move
+ **/
+void patterns3x3_updateDirty( PatternsPlayout* playout, Board* board )
+{
+  for( int d=0; d<playout->dirtyNum; d++ ){
+    INTERSECTION intersection = playout->dirty[d];
+    playout->dirtyMap[intersection] = 0;
+    patterns3x3_update(playout, board, intersection);
+  }
+  playout->dirtyNum = 0;
+}
+
+/**
+ * @brief Computes all the weights
+ **/
+void patterns3x3_build( PatternsPlayout* playout, Board* board )
+{
+  Sampler_clear(&playout->samplers[BLACK], board);
+  Sampler_clear(&playout->samplers[WHITE], board);
+  memset(playout->dirtyMap, 0, sizeof(playout->dirtyMap));
+  playout->dirtyNum = 0;
+
+  int empty;
+  for( EMPTIES(board) ){
+    empty = EMPTYI(board);
+    patterns3x3_update(playout, board, empty);
+  }
+}
+
+/**
+ * @brief Picks a move for current turn's player proportionally to
+ * the weights
+ *
+ * @return The move, or PASS if there are no moves with weight
+ **/
+INTERSECTION patterns3x3_sample( PatternsPlayout* playout, Board* board )
+{
+  while( 1 ){
+    INTERSECTION intersection = 
+      Sampler_sample(&playout->samplers[board->turn], &threadRng);
+    if( intersection == PASS ) return PASS;
+
+    // Weights of moves whose pattern did not change might be outdated
+    if( Board_isLegalNoEyeFilling(board, intersection) ) return intersection;
+    patterns3x3_update(playout, board, intersection);
+  }
+}
+
+/**
+ * @brief Frees the playout state
+ **/
+void patterns3x3_teardown( Policy* policy )
+{
+  free(policy->ctx);
+}
+
+int POLICY_patterns3x3Initialize( Policy* policy )
+{
+  if( !patternWeightsInitialized ) patterns3x3_initializeWeights();
+
+  policy->ctx = malloc(sizeof(PatternsPlayout));
+  if( !policy->ctx ) return 0;
+
+  policy->playout = &POLICY_patterns3x3;
+  policy->teardown = &patterns3x3_teardown;
+  return 1;
+}
+
+Color POLICY_patterns3x3( Policy* policy, Board* board, BoardIterator* iter,
+			  float komi, unsigned char* playedMoves )
+{
+  PatternsPlayout* playout = (PatternsPlayout*)policy->ctx;
+  patterns3x3_build(playout, board);
+  board->patternHook = &patterns3x3_patternChanged;
+  board->patternHookCtx = playout;
+  Policy_start( policy, board );
+
+  int passed = 0, moves = 0;
+  while( moves < PLAYOUT_MOVES_MAX ){
+    INTERSECTION move = patterns3x3_sample(playout, board);
+    INTERSECTION ko = board->koPosition;
+    moves++;
+
+    if( move == PASS ){
+      if( passed ) break;
+      passed = 1;
+      Board_pass(board);
+    }
+    else{
+      passed = 0;
+      Board_play(board, move);
+
+      // Mark the move as played
+      playedMoves[move] |= (!board->turn)+1;
+
+      if( Policy_mercyWinner(policy, board) != EMPTY ) break;
+    }
+
+    // The former ko becomes playable
+    patterns3x3_updateDirty(playout, board);
+    if( ko != -1 ) patterns3x3_update(playout, board, ko);
+  }
+
+  board->patternHook = NULL;
+  board->patternHookCtx = NULL;
+
+  // Endgame!
+  return Policy_finish( policy, board, iter, komi, moves );
+}
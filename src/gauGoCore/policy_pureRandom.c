@@ -9,67 +9,46 @@
 #include "policies.h"
 
 /**
- * @brief Determines if the specified move is legal and 
- * not self-eye filling.
- **/
-int pureRandom_isPlayableMove( Board* board, INTERSECTION move )
-{
-  return Board_isLegalNoEyeFilling( board, move );
-}
-
-/**
- * @brief Play a random move uniformely over empty squares.
+ * @brief Play a random move over playable intersections.
  **/
 INTERSECTION pureRandom_playRandom(Board* board)
 {
-  // Linearly tries all moves from random point on
-  int randomPoint = rand() % board->emptiesNum;
-  
-  for(int i=randomPoint; i<board->emptiesNum; i++){
-    int intersection = board->empties[i];
-    // Play it
-    if( pureRandom_isPlayableMove( board,  intersection ) ){
-      // play move
-      Board_play( board, intersection );
-      return intersection;
-    }
-  }
+  INTERSECTION intersection = Board_randomPlayable( board, &threadRng );
 
-  for(int i=0; i<randomPoint; i++){
-    int intersection = board->empties[i];
-    // Play it
-    if( pureRandom_isPlayableMove( board,  intersection ) ){
-      // play move
-      Board_play( board, intersection );
-      return intersection;
-    }
-  }
-  
   // No moves available - pass
-  Board_pass( board );
-  return PASS;
+  if( intersection == PASS ){
+    Board_pass( board );
+  }
+  else{
+    Board_play( board, intersection );
+  }
+
+  return intersection;
 }
 
-Color POLICY_pureRandom( Board* board, BoardIterator* iter, 
+Color POLICY_pureRandom( Policy* policy, Board* board, BoardIterator* iter, 
 			 float komi, unsigned char* playedMoves )
 {
-  int passed = 0;
-  for( int m=0; m<PLAYOUT_MOVES_MAX; m++ ){
+  Policy_start( policy, board );
+
+  int passed = 0, moves = 0;
+  while( moves < PLAYOUT_MOVES_MAX ){
     INTERSECTION move = pureRandom_playRandom( board );
+    moves++;
 
     if( move == PASS ){
-      if( passed ){
-	// Endgame!
-	int score = (float)Board_trompTaylorScore( board, iter );
-	return (score > komi) ? BLACK : WHITE;
-      }
+      // Endgame!
+      if( passed ) break;
       passed = 1;
     } else {
       passed = 0;
 
       // Mark the move as played
       playedMoves[move] |= (!board->turn)+1;
+
+      if( Policy_mercyWinner( policy, board ) != EMPTY ) break;
     }
   }
-}
 
+  return Policy_finish( policy, board, iter, komi, moves );
+}
@@ -0,0 +1,146 @@
+/**
+ * @file  priors.c
+ * @brief Prior knowledge implementation
+ *
+ **/
+
+#include "priors.h"
+#include "hfeatures.h"
+
+/**
+ * @brief Minimum finished playouts before criticality is trusted
+ **/
+#define PRIORS_CRITICALITY_PLAYOUTS 500
+
+/**
+ * @brief Criticality above which an intersection gets the prior 
+ * (a fifth of the highest one)
+ **/
+#define PRIORS_CRITICALITY_MIN 0.1f
+
+/**
+ * @brief Adds virtual playouts with the specified win rate
+ **/
+void Priors_add(Prior* prior, int played, float winRate)
+{
+  prior->played += played;
+  prior->wins += played * winRate;
+}
+
+/**
+ * @brief Determines if the move captures an opponent group
+ **/
+int Priors_isCapture(Board* board, INTERSECTION move)
+{
+  int neigh;
+  for( NEIGHBORS(move) ){
+    neigh = NEIGHI(board, move);
+    if( board->intersectionMap[neigh] == !board->turn
+	&& StoneGroup_isAtari(&board->groups[board->groupMap[neigh]]) ){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Determines if the move extends a group in atari that a
+ * ladder still captures
+ **/
+int Priors_isLadderExtension(Board* board, INTERSECTION move)
+{
+  int neigh;
+  for( NEIGHBORS(move) ){
+    neigh = NEIGHI(board, move);
+    GRID group = board->groupMap[neigh];
+    if( board->intersectionMap[neigh] == board->turn
+	&& StoneGroup_isAtari(&board->groups[group])
+	&& Board_ladderCapturable(board, group) ){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Determines if the move is an atari that captures the
+ * opponent group in a ladder
+ **/
+int Priors_isLadderAtari(Board* board, INTERSECTION move)
+{
+  int neigh;
+  for( NEIGHBORS(move) ){
+    neigh = NEIGHI(board, move);
+    if( board->intersectionMap[neigh] == !board->turn
+	&& Board_ladderAtariCaptures(board, board->groupMap[neigh], move) ){
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Obtains the distance from the move to the closest edge
+ * (0 for the first line)
+ **/
+int Priors_edgeDistance(Board* board, INTERSECTION move)
+{
+  int x = Board_intersectionX(board, move);
+  int y = Board_intersectionY(board, move);
+  return MIN(MIN(x, board->size-1-x), MIN(y, board->size-1-y));
+}
+
+void Priors_evaluate(Board* board, INTERSECTION move, PlayoutStats* stats,
+		     int visits, Prior* prior)
+{
+  prior->played = 0;
+  prior->wins = 0;
+
+  // Even prior: no unexplored children
+  Priors_add(prior, visits, 0.5f);
+
+  // Tactics
+  if( Priors_isCapture(board, move) ){
+    Priors_add(prior, 2*visits, 1.0f);
+  }
+  else if( Features_selfAtari(board, move) ){
+    Priors_add(prior, 2*visits, 0.0f);
+  }
+  // Running into a ladder only adds stones to the capture
+  if( Features_extension(board, move) ){
+    if( Priors_isLadderExtension(board, move) ){
+      Priors_add(prior, 2*visits, 0.1f);
+    }
+    else Priors_add(prior, 2*visits, 0.9f);
+  }
+  int atari = Features_atari(board, move);
+  if( atari && Priors_isLadderAtari(board, move) ){
+    Priors_add(prior, 2*visits, 0.9f);
+  }
+  else switch( atari ){
+  case 1: Priors_add(prior, visits, 0.6f); break;
+  case 2: Priors_add(prior, visits, 0.7f); break;
+  }
+
+  // Shape and locality
+  if( POLICY_mogoPattern(board, move) ){
+    Priors_add(prior, visits, 0.8f);
+  }
+  if( Features_distancePrevious(board, move) ){
+    Priors_add(prior, visits, 0.6f);
+  }
+
+  // Edge lines, away from other stones
+  if( !(board->patterns3x3[move] & 0xAAAA) ){
+    switch( Priors_edgeDistance(board, move) ){
+    case 0: Priors_add(prior, visits, 0.1f); break;
+    case 2: Priors_add(prior, visits, 0.6f); break;
+    }
+  }
+
+  // Intersections that decide the playouts
+  if( stats && stats->finished >= PRIORS_CRITICALITY_PLAYOUTS
+      && PlayoutStats_criticality(stats, move) > PRIORS_CRITICALITY_MIN ){
+    Priors_add(prior, visits, 0.7f);
+  }
+}
@@ -0,0 +1,44 @@
+/**
+ * @file  priors.h
+ * @brief Provides prior knowledge about moves, used to initialize
+ * new nodes of the UCT tree.
+ *
+ * The prior of a move is given as virtual playouts and wins, from the
+ * point of view of the player to move, computed from cheap heuristics
+ * (captures, ataris, self-ataris, 3x3 patterns, distance to the last
+ * move, edge lines and playout criticality).
+ *
+ **/
+#ifndef PRIORS_H
+#define PRIORS_H
+
+#include "board.h"
+#include "policies.h"
+
+/**
+ * @brief Virtual playouts and wins of a move
+ **/
+typedef struct Prior
+{
+  /** Virtual playouts */
+  int played;
+  /** Virtual wins for the player to move */
+  int wins;
+
+} Prior;
+
+/**
+ * @brief Computes the prior of a legal move for current turn's player
+ *
+ * @param board The position
+ * @param move The move
+ * @param stats Playout statistics of the search so far, for 
+ * criticality (NULL: not used)
+ * @param visits Virtual playouts of a single heuristic (an even
+ * prior of that many playouts is always given)
+ * @param prior The prior to compute
+ **/
+void Priors_evaluate(Board* board, INTERSECTION move, PlayoutStats* stats,
+		     int visits, Prior* prior);
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file rng.c
+ * @brief Random number generator implementation
+ *
+ **/
+
+#include "rng.h"
+
+__thread Rng threadRng = { { 0x8a5cd789635d2dffULL, 0x121fd2155c472f96ULL } };
+
+void Rng_seed(Rng* rng, unsigned long long seed)
+{
+  // Spread the seed over the state with splitmix64, 
+  // which never gives an all-zero state
+  for( int k=0; k<2; k++ ){
+    unsigned long long z = (seed += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    rng->s[k] = z ^ (z >> 31);
+  }
+}
+
+unsigned long long Rng_next(Rng* rng)
+{
+  unsigned long long s1 = rng->s[0];
+  const unsigned long long s0 = rng->s[1];
+  rng->s[0] = s0;
+  s1 ^= s1 << 23;
+  rng->s[1] = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+  return rng->s[1] + s0;
+}
+
+unsigned int Rng_range(Rng* rng, unsigned int range)
+{
+  // Lemire's multiply-shift: the high 32 bits of (random * range).
+  // The few low products below 2^32 % range are rejected.
+  unsigned long long m = (Rng_next(rng) >> 32) * range;
+  unsigned int low = (unsigned int)m;
+  if( low < range ){
+    unsigned int threshold = -range % range;
+    while( low < threshold ){
+      m = (Rng_next(rng) >> 32) * range;
+      low = (unsigned int)m;
+    }
+  }
+  return m >> 32;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file  rng.h
+ * @brief Provides a fast pseudo-random number generator (xorshift128+).
+ *
+ * Every generator keeps its own state, so that threads do not share
+ * (and lock) a global state like libc rand() does.  Playout policies
+ * use the generator of the calling thread, threadRng.
+ *
+ **/
+#ifndef RNG_H
+#define RNG_H
+
+/**
+ * @brief State of a random number generator
+ **/
+typedef struct Rng
+{
+  unsigned long long s[2];
+
+} Rng;
+
+/**
+ * @brief The generator of the current thread, used by playout 
+ * policies.  It starts from a fixed state in every thread.
+ **/
+extern __thread Rng threadRng;
+
+/**
+ * @brief Seeds a generator.  The same seed always gives the
+ * same sequence.
+ *
+ * @param rng The generator
+ * @param seed Any value
+ **/
+void Rng_seed(Rng* rng, unsigned long long seed);
+
+/**
+ * @brief Generates the next random number
+ *
+ * @param rng The generator
+ * @return A uniformly distributed 64 bits value
+ **/
+unsigned long long Rng_next(Rng* rng);
+
+/**
+ * @brief Generates a random number in [0, range), without
+ * modulo bias and (almost always) without division
+ *
+ * @param rng The generator
+ * @param range The size of the range (must be positive)
+ * @return A uniformly distributed value in [0, range)
+ **/
+unsigned int Rng_range(Rng* rng, unsigned int range);
+
+#endif
@@ -0,0 +1,44 @@
+/**
+ * @file  sampler.c
+ * @brief Weighted intersections sampler implementation
+ *
+ **/
+
+#include <string.h>
+#include "sampler.h"
+
+void Sampler_clear(Sampler* sampler, Board* board)
+{
+  memset(sampler, 0, sizeof(Sampler));
+  sampler->rowLength = board->size+1;
+}
+
+void Sampler_set(Sampler* sampler, INTERSECTION intersection, 
+		 unsigned int weight)
+{
+  unsigned int old = sampler->weights[intersection];
+  int row = intersection / sampler->rowLength;
+
+  sampler->weights[intersection] = weight;
+  sampler->rowSums[row] += weight - old;
+  sampler->total += weight - old;
+}
+
+INTERSECTION Sampler_sample(Sampler* sampler, Rng* rng)
+{
+  if( !sampler->total ) return PASS;
+
+  unsigned int r = Rng_range(rng, sampler->total);
+
+  // Find the row, then the intersection
+  int row = 0;
+  while( r >= sampler->rowSums[row] ){
+    r -= sampler->rowSums[row++];
+  }
+  INTERSECTION intersection = row * sampler->rowLength;
+  while( r >= sampler->weights[intersection] ){
+    r -= sampler->weights[intersection++];
+  }
+
+  return intersection;
+}
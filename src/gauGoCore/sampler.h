@@ -0,0 +1,61 @@
+/**
+ * @file  sampler.h
+ * @brief Provides weighted random selection of intersections.
+ *
+ * Every intersection has a weight, and intersections are picked
+ * with probability proportional to it.  Weights are kept with
+ * their sums by board row, so that changing a weight is O(1) and
+ * picking an intersection is O(board size).  Playout policies only
+ * change the weights of a few intersections around every move.
+ *
+ **/
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include "board.h"
+#include "rng.h"
+
+/**
+ * @brief Weights of all intersections of a board, with sums
+ * by board row
+ **/
+typedef struct Sampler
+{
+  unsigned int weights[MAX_INTERSECTION_NUM];
+  /** Rows 0 to size+2: the last border intersection is alone
+      in row size+2 */
+  unsigned int rowSums[MAX_BOARD_SIZE+3];
+  unsigned int total;
+  int rowLength;
+
+} Sampler;
+
+/**
+ * @brief Sets all the weights to 0
+ *
+ * @param sampler The sampler
+ * @param board The board whose intersections are going to be sampled
+ **/
+void Sampler_clear(Sampler* sampler, Board* board);
+
+/**
+ * @brief Changes the weight of an intersection
+ *
+ * @param sampler The sampler
+ * @param intersection The intersection
+ * @param weight The new weight
+ **/
+void Sampler_set(Sampler* sampler, INTERSECTION intersection, 
+		 unsigned int weight);
+
+/**
+ * @brief Picks an intersection with probability proportional to
+ * its weight
+ *
+ * @param sampler The sampler
+ * @param rng The random number generator to use
+ * @return The intersection, or PASS if all weights are 0
+ **/
+INTERSECTION Sampler_sample(Sampler* sampler, Rng* rng);
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @file scoring.c
+ * @brief Scoring implementation
+ *
+ **/
+
+#include "scoring.h"
+#include "policies.h"
+
+#include <string.h>
+
+void Scoring_estimateDeadStones(Board* board, float komi, int playouts,
+				Bitboard* dead)
+{
+  BoardIterator it;
+  Board_iterator(board, &it);
+
+  // Ownership of every intersection at the end of random playouts
+  PlayoutStats stats;
+  PlayoutStats_clear(&stats);
+
+  Policy policy;
+  Policy_initialize(&policy, POLICY_ID_PURERANDOM);
+  Policy_playouts(&policy, board, komi, playouts, &stats);
+  Policy_teardown(&policy);
+
+  // A group is dead if its stones are mostly owned by the opponent
+  Bitboard_clear(dead);
+  unsigned char visited[MAX_INTERSECTION_NUM];
+  memset(visited, 0, sizeof(visited));
+
+  INTERSECTION intersection;
+  for( INTERSECTIONS((&it)) ){
+    intersection = INTERSECTIONI((&it));
+    Color color = board->intersectionMap[intersection];
+    GRID group = board->groupMap[intersection];
+    if( color > WHITE || visited[group] ) continue;
+    visited[group] = 1;
+
+    int balance = 0;
+    for( STONES(board, group) ){
+      balance += stats.owned[BLACK][STONEI()] - stats.owned[WHITE][STONEI()];
+    }
+    if( color == WHITE ) balance = -balance;
+
+    if( balance < 0 ){
+      for( STONES(board, group) ){
+	BITBOARD_SET(dead, STONEI());
+      }
+    }
+  }
+}
+
+float Scoring_finalScore(Board* board, float komi, int playouts)
+{
+  Bitboard dead;
+  Scoring_estimateDeadStones(board, komi, playouts, &dead);
+  return Board_areaScore(board, &dead) - komi;
+}
+
+/**
+ * @brief Determines if an intersection is space for area counting,
+ * that is, empty or a dead stone
+ **/
+int scoring_isSpace(Board* board, const Bitboard* dead, INTERSECTION intersection)
+{
+  return board->intersectionMap[intersection] == EMPTY
+    || (board->intersectionMap[intersection] <= WHITE 
+	&& BITBOARD_TEST(dead, intersection));
+}
+
+StoneStatus Scoring_stoneStatus(Board* board, const Bitboard* dead,
+				Color* owner, INTERSECTION stone)
+{
+  if( BITBOARD_TEST(dead, stone) ) return STATUS_DEAD;
+
+  Color color = board->intersectionMap[stone];
+
+  // Flood the block of alive chains connected through their own 
+  // territory, counting the separate eye areas it encloses, their
+  // size, and the neutral areas it shares with the opponent
+  int eyes = 0, eyeArea = 0, sharedAreas = 0;
+  Bitboard visited;
+  Bitboard_clear(&visited);
+  INTERSECTION stones[MAX_INTERSECTION_NUM], area[MAX_INTERSECTION_NUM];
+  int stonesNum = 0, areaNum = 0;
+  stones[stonesNum++] = stone;
+  BITBOARD_SET(&visited, stone);
+
+  while( stonesNum > 0 ){
+    INTERSECTION st = stones[--stonesNum];
+    int neigh;
+    for( NEIGHBORS(st) ){
+      neigh = NEIGHI(board, st);
+      if( board->intersectionMap[neigh] == BORDER
+	  || BITBOARD_TEST(&visited, neigh) ) continue;
+
+      if( !scoring_isSpace(board, dead, neigh) ){
+	// Alive chain of the same color
+	if( board->intersectionMap[neigh] == color ){
+	  BITBOARD_SET(&visited, neigh);
+	  stones[stonesNum++] = neigh;
+	}
+	continue;
+      }
+
+      BITBOARD_SET(&visited, neigh);
+
+      // Own territory: a new eye area, to be flooded with the chains
+      // around it
+      if( owner[neigh] == color ){
+	eyes++;
+	area[areaNum++] = neigh;
+	while( areaNum > 0 ){
+	  INTERSECTION point = area[--areaNum];
+	  eyeArea++;
+	  int neigh2;
+	  for( NEIGHBORS2(point, j) ){
+	    neigh2 = NEIGHI2(board, point, j);
+	    if( board->intersectionMap[neigh2] == BORDER
+		|| BITBOARD_TEST(&visited, neigh2) ) continue;
+	    if( scoring_isSpace(board, dead, neigh2) ){
+	      if( owner[neigh2] != color ) continue;
+	      BITBOARD_SET(&visited, neigh2);
+	      area[areaNum++] = neigh2;
+	    }
+	    else if( board->intersectionMap[neigh2] == color ){
+	      BITBOARD_SET(&visited, neigh2);
+	      stones[stonesNum++] = neigh2;
+	    }
+	  }
+	}
+      }
+      // Neutral area: shared if it is a small pocket that an alive
+      // opponent stone touches too
+      else if( owner[neigh] == EMPTY ){
+	int pocket = 0, touched = 0;
+	area[areaNum++] = neigh;
+	while( areaNum > 0 ){
+	  INTERSECTION point = area[--areaNum];
+	  pocket++;
+	  int neigh2;
+	  for( NEIGHBORS2(point, j) ){
+	    neigh2 = NEIGHI2(board, point, j);
+	    if( board->intersectionMap[neigh2] == BORDER
+		|| BITBOARD_TEST(&visited, neigh2) ) continue;
+	    if( scoring_isSpace(board, dead, neigh2) ){
+	      if( owner[neigh2] != EMPTY ) continue;
+	      BITBOARD_SET(&visited, neigh2);
+	      area[areaNum++] = neigh2;
+	    }
+	    else if( board->intersectionMap[neigh2] == !color ){
+	      touched = 1;
+	    }
+	  }
+	}
+	if( touched && pocket <= SCORING_SEKI_AREA_MAX ) sharedAreas++;
+      }
+    }
+  }
+
+  // Alive without two eyes, nor room enough to make them: seki
+  if( sharedAreas > 0 && eyes < 2 && eyeArea <= SCORING_SEKI_AREA_MAX ){
+    return STATUS_SEKI;
+  }
+  return STATUS_ALIVE;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file  scoring.h
+ * @brief Provides scoring of real game endings, where dead stones
+ * are still on the board and dame might not be filled.
+ *
+ * Dead stones are estimated by Monte-Carlo ownership: random playouts
+ * are run from the position, and stones that end up owned by the opponent
+ * in most of them are considered dead.
+ *
+ **/
+#ifndef SCORING_H
+#define SCORING_H
+
+#include "board.h"
+#include "bitboard.h"
+
+/**
+ * @brief Largest eye area an alive block of chains in seki may enclose
+ * (a bigger one is enough to make two eyes), and largest neutral area
+ * it may share with the opponent (a bigger one is not settled yet)
+ **/
+#define SCORING_SEKI_AREA_MAX 6
+
+/**
+ * @brief Status of a stone at the end of the game
+ **/
+typedef enum {
+  STATUS_ALIVE,
+  STATUS_DEAD,
+  STATUS_SEKI
+} StoneStatus;
+
+/**
+ * @brief Estimates the dead stones of a position.
+ * A stone group is dead if, averaged over all of its stones and
+ * all playouts, it is owned by the opponent more often than not.
+ *
+ * @param board The board (left unchanged)
+ * @param komi The komi used for playouts
+ * @param playouts The number of random playouts to play
+ * @param dead Bitboard to which the dead stones will be written
+ **/
+void Scoring_estimateDeadStones(Board* board, float komi, int playouts,
+				Bitboard* dead);
+
+/**
+ * @brief Computes the final score of a position by area counting,
+ * after removing the estimated dead stones.
+ *
+ * @param board The board (left unchanged)
+ * @param komi The komi
+ * @param playouts The number of random playouts used to estimate dead stones
+ * @return The score from black's point of view, komi included
+ **/
+float Scoring_finalScore(Board* board, float komi, int playouts);
+
+/**
+ * @brief Obtains the final status of a stone, given the dead stones.
+ * Status is decided for the whole block of alive chains connected to
+ * the stone through their own territory: the block is in seki if it
+ * shares a small neutral area with an opponent alive chain, while
+ * enclosing less than two separate eye areas.  Small areas are those
+ * of SCORING_SEKI_AREA_MAX points at most, for both territory and
+ * neutral areas.
+ *
+ * @param board The board
+ * @param dead The dead stones
+ * @param owner The ownership map resulting from Board_areaOwnership with
+ * the same dead stones
+ * @param stone The intersection of the stone
+ * @return The final status of the stone
+ **/
+StoneStatus Scoring_stoneStatus(Board* board, const Bitboard* dead,
+				Color* owner, INTERSECTION stone);
+
+#endif
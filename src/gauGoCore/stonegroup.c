@@ -66,6 +66,9 @@ void StoneGroup_addLib(StoneGroup* group, INTERSECTION lib)
   group->libertiesNum++;
   group->libSum += lib;
   group->libSumSq += intSquared[lib];
+#ifdef EXACT_LIBERTIES
+  BITBOARD_SET(&group->libBits, lib);
+#endif
 }
 
 /**
@@ -76,4 +79,7 @@ void StoneGroup_subLib(StoneGroup* group, INTERSECTION lib)
   group->libertiesNum--;
   group->libSum -= lib;
   group->libSumSq -= intSquared[lib];  
+#ifdef EXACT_LIBERTIES
+  BITBOARD_UNSET(&group->libBits, lib);
+#endif
 }
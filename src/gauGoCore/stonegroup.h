@@ -11,6 +11,7 @@
 #define STONEGROUP_H
 
 #include "global_defs.h"
+#include "bitboard.h"
 
 /**
  * @brief Represents a fully connected group of stones
@@ -43,6 +44,13 @@ typedef struct StoneGroup
    **/
   INTERSECTION groupHead;
 
+#ifdef EXACT_LIBERTIES
+  /**
+   * The exact set of liberties (each liberty only once)
+   **/
+  Bitboard libBits;
+#endif
+
 } StoneGroup;
 
 
@@ -6,12 +6,33 @@
 
 #include "stoppers.h"
 #include <unistd.h>
+#include <limits.h>
+
+/**
+ * @brief Simulations between two checks for an early stop
+ * of STOPPER_time
+ **/
+#define STOPPER_TIME_CHECK 64
+
+/**
+ * @brief Simulations of STOPPER_5ksim, and between two checks
+ * for an early stop
+ **/
+#define STOPPER_SIMULATIONS 50000
+#define STOPPER_DECISION_CHECK 1000
 
 void printTreeInfo( UCTSearch* search )
 {
 }
 
-int STOPPER_5ksim( UCTSearch* search, int simulations )
+/**
+ * @brief Prints search info every 3000 simulations, depending
+ * on the options
+ *
+ * @param search The search going on
+ * @param simulations Simulations played so far
+ **/
+void stoppers_printInfo( UCTSearch* search, int simulations )
 {
   if( simulations % 3000 == 0 ){
     
@@ -19,11 +40,11 @@ int STOPPER_5ksim( UCTSearch* search, int simulations )
     if( search->options->verbosity > 0 ){
       // Header
       if( simulations == 3000 ){
-	UCTSearch_printSearchInfoHeader();
+	UCTSearch_printSearchInfoHeader( search );
       }
       // Line
       UCTSearch_printSearchInfo( search );
-      fflush(stdout);
+      fflush(search->out);
     }
 
     // Prints gogui live gfx if in gogui mode
@@ -32,6 +53,77 @@ int STOPPER_5ksim( UCTSearch* search, int simulations )
       fflush(stderr);
     }
   }
-  return simulations >= 50000;
 }
 
+/**
+ * @brief Determines if the move to be played is already decided:
+ * the most played root child leads the runner-up by more than
+ * the simulations left
+ *
+ * @param search The search going on
+ * @param remaining Simulations left to the search
+ * @return 1 if the move cannot change, 0 otherwise
+ **/
+int stoppers_decided( UCTSearch* search, int remaining )
+{
+  UCTNode* root = &search->tree->root;
+  int best = 0, second = 0;
+  foreach_child( root ){
+    if( child->played > best ){
+      second = best;
+      best = child->played;
+    }
+    else if( child->played > second ){
+      second = child->played;
+    }
+  }
+  return best - second > remaining;
+}
+
+int STOPPER_5ksim( UCTSearch* search, int simulations )
+{
+  stoppers_printInfo( search, simulations );
+  if( simulations >= STOPPER_SIMULATIONS ) return 1;
+
+  // Stop early when the rest of the simulations cannot change the move
+  if( simulations % STOPPER_DECISION_CHECK ) return 0;
+  return stoppers_decided( search, STOPPER_SIMULATIONS - simulations );
+}
+
+int STOPPER_analyze( UCTSearch* search, int simulations )
+{
+  (void)simulations;
+
+  // Analysis line when its time has come
+  int elapsed = CycleTimer_getElapsedTime( &search->cycleTimer );
+  if( elapsed >= search->nextAnalysis ){
+    UCTSearch_printAnalysis( search );
+    fflush(search->out);
+    search->nextAnalysis = elapsed + search->analysisInterval;
+  }
+
+  // Only the tree memory limits the search
+  return search->tree->poolsNum >= MAX_POOLS;
+}
+
+int STOPPER_time( UCTSearch* search, int simulations )
+{
+  stoppers_printInfo( search, simulations );
+
+  // The tree is about to run out of memory
+  if( search->tree->poolsNum >= MAX_POOLS ) return 1;
+
+  // The cycle timer is cheap enough to be read every simulation
+  if( CycleTimer_getElapsedTime( &search->cycleTimer ) >= search->maxTime ){
+    return 1;
+  }
+
+  // Stop early when the simulations the time left allows at the 
+  // current speed cannot change the move, saving time for later
+  if( simulations % STOPPER_TIME_CHECK ) return 0;
+  int elapsed = Timer_getElapsedTime( &search->timer );
+  if( elapsed == 0 ) return 0;
+  long long remaining = 
+    (long long)(search->maxTime - elapsed) * simulations / elapsed;
+  return stoppers_decided( search, MIN(remaining, INT_MAX) );
+}
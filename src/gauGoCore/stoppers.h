@@ -9,8 +9,24 @@
 #include "uctSearch.h"
 
 /**
- * @brief Default stopper policy with 5k simulations
+ * @brief Default stopper policy with 50k simulations, or less if
+ * the move to play cannot change anymore
  **/
 int STOPPER_5ksim( UCTSearch* search, int simulations );
 
+/**
+ * @brief Stops when the search has used its time (search->maxTime),
+ * or when the tree is running out of memory, or when the move to play
+ * cannot change in the time left.  The deadline is checked with 
+ * the search's cycle timer.
+ **/
+int STOPPER_time( UCTSearch* search, int simulations );
+
+/**
+ * @brief Never stops by itself (the search must be interrupted), 
+ * unless the tree is running out of memory.  Prints an analysis 
+ * line every search->analysisInterval milliseconds.
+ **/
+int STOPPER_analyze( UCTSearch* search, int simulations );
+
 #endif
@@ -0,0 +1,106 @@
+/**
+ * @file  timeControl.c
+ * @brief Game clocks, and time allocation for the search
+ *
+ **/
+
+#include <string.h>
+#include "timeControl.h"
+#include "global_defs.h"
+
+/**
+ * @brief Moves a player is always expected to play in main time,
+ * plus one every TIME_CONTROL_EMPTIES_PER_MOVE empty intersections
+ **/
+#define TIME_CONTROL_MIN_MOVES 10
+#define TIME_CONTROL_EMPTIES_PER_MOVE 4
+
+void TimeControl_initialize( TimeControl* tc )
+{
+  memset(tc, 0, sizeof(TimeControl));
+}
+
+void TimeControl_set( TimeControl* tc, int mainTime, ByoYomi byoYomi,
+		      int byoYomiTime, int byoYomiStones )
+{
+  tc->limited = 1;
+  tc->mainTime = mainTime;
+  tc->byoYomi = byoYomiStones > 0 ? byoYomi : BYOYOMI_NONE;
+  tc->byoYomiTime = byoYomiTime;
+  tc->byoYomiStones = byoYomiStones;
+
+  for( Color color=BLACK; color<=WHITE; color++ ){
+    TimeControl_setClock( tc, color, mainTime, 0 );
+  }
+}
+
+void TimeControl_setClock( TimeControl* tc, Color color,
+			   int timeLeft, int stonesLeft )
+{
+  tc->clocks[color].timeLeft = timeLeft;
+  tc->clocks[color].stonesLeft = stonesLeft;
+}
+
+void TimeControl_moveDone( TimeControl* tc, Color color, int elapsed )
+{
+  if( !tc->limited ) return;
+
+  Clock* clock = &tc->clocks[color];
+  clock->timeLeft -= elapsed;
+
+  // In main time, until it runs out
+  if( clock->stonesLeft == 0 ){
+    if( clock->timeLeft > 0 || tc->byoYomi == BYOYOMI_NONE ) return;
+
+    // The rest of the move is played in the first period
+    elapsed = -clock->timeLeft;
+    clock->timeLeft = tc->byoYomiTime - elapsed;
+    clock->stonesLeft = tc->byoYomiStones;
+  }
+
+  switch( tc->byoYomi ){
+  case BYOYOMI_CANADIAN:
+    // New period when all its stones are played
+    if( --clock->stonesLeft == 0 ){
+      clock->timeLeft = tc->byoYomiTime;
+      clock->stonesLeft = tc->byoYomiStones;
+    }
+    break;
+  case BYOYOMI_JAPANESE:
+    // A period is lost when overtime, the next move starts a new one
+    if( clock->timeLeft < 0 && clock->stonesLeft > 1 ) clock->stonesLeft--;
+    clock->timeLeft = tc->byoYomiTime;
+    break;
+  default: break;
+  }
+}
+
+int TimeControl_moveTime( TimeControl* tc, Board* board )
+{
+  if( !tc->limited ) return 0;
+
+  Clock* clock = &tc->clocks[board->turn];
+  int moveTime;
+
+  // In byo-yomi, spread the period over its stones
+  if( clock->stonesLeft > 0 ){
+    moveTime = tc->byoYomi == BYOYOMI_CANADIAN ?
+      clock->timeLeft / clock->stonesLeft : clock->timeLeft;
+  }
+
+  // In main time, spread it over the moves left, plus what byo-yomi
+  // gives for every move anyway
+  else{
+    int movesLeft = TIME_CONTROL_MIN_MOVES
+      + board->emptiesNum / TIME_CONTROL_EMPTIES_PER_MOVE;
+    moveTime = clock->timeLeft / movesLeft;
+    switch( tc->byoYomi ){
+    case BYOYOMI_CANADIAN: moveTime += tc->byoYomiTime / tc->byoYomiStones; break;
+    case BYOYOMI_JAPANESE: moveTime += tc->byoYomiTime; break;
+    default: break;
+    }
+  }
+
+  // Never 0, which means no limit
+  return MAX( moveTime - TIME_CONTROL_LAG, 1 );
+}
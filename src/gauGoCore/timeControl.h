@@ -0,0 +1,118 @@
+/**
+ * @file  timeControl.h
+ * @brief Game clocks, and time allocation for the search
+ *
+ * The time settings are given by the controller (GTP time_settings or
+ * kgs-time_settings), and the clocks kept up to date with time_left.
+ * Without time settings, there is no time limit.
+ *
+ **/
+#ifndef TIMECONTROL_H
+#define TIMECONTROL_H
+
+#include "board.h"
+
+/**
+ * @brief Safety margin for every move, for network lag and the
+ * time spent outside the search (milliseconds)
+ **/
+#define TIME_CONTROL_LAG 300
+
+/**
+ * @brief Kinds of byo-yomi
+ **/
+typedef enum {
+  BYOYOMI_NONE,
+  BYOYOMI_CANADIAN,
+  BYOYOMI_JAPANESE
+} ByoYomi;
+
+/**
+ * @brief One player's clock
+ **/
+typedef struct Clock
+{
+  /** Time left: main time, or the current byo-yomi period (ms) */
+  int timeLeft;
+
+  /** Stones left in the period (canadian) or periods left (japanese),
+      0 while in main time */
+  int stonesLeft;
+
+} Clock;
+
+/**
+ * @brief Time settings and both players' clocks
+ **/
+typedef struct TimeControl
+{
+  /** Whether there is a time limit at all */
+  int limited;
+
+  /** Main time (ms) */
+  int mainTime;
+
+  /** Byo-yomi kind, period time (ms), and stones per period
+      (canadian) or number of periods (japanese) */
+  ByoYomi byoYomi;
+  int byoYomiTime;
+  int byoYomiStones;
+
+  /** Clocks, by color */
+  Clock clocks[2];
+
+} TimeControl;
+
+/**
+ * @brief Sets up a time control without time limit
+ *
+ * @param tc The time control
+ **/
+void TimeControl_initialize( TimeControl* tc );
+
+/**
+ * @brief Sets new time settings, and resets both clocks to them
+ *
+ * @param tc The time control
+ * @param mainTime Main time (ms)
+ * @param byoYomi Byo-yomi kind
+ * @param byoYomiTime Byo-yomi period time (ms)
+ * @param byoYomiStones Stones per period (canadian) or
+ * periods (japanese)
+ **/
+void TimeControl_set( TimeControl* tc, int mainTime, ByoYomi byoYomi,
+		      int byoYomiTime, int byoYomiStones );
+
+/**
+ * @brief Sets a player's clock as reported by the controller
+ *
+ * @param tc The time control
+ * @param color The player
+ * @param timeLeft Time left in main time or in the period (ms)
+ * @param stonesLeft Stones or periods left (0: in main time)
+ **/
+void TimeControl_setClock( TimeControl* tc, Color color,
+			   int timeLeft, int stonesLeft );
+
+/**
+ * @brief Updates a player's clock after a move, for controllers that
+ * do not send time_left
+ *
+ * @param tc The time control
+ * @param color The player who moved
+ * @param elapsed Time spent on the move (ms)
+ **/
+void TimeControl_moveDone( TimeControl* tc, Color color, int elapsed );
+
+/**
+ * @brief Allocates time for the next move of the player to play,
+ * from the time left and the number of moves expected, estimated
+ * from the empty intersections
+ *
+ * @param tc The time control
+ * @param board The position
+ * @return The time for the move (ms), 0 if there is no time limit
+ **/
+int TimeControl_moveTime( TimeControl* tc, Board* board );
+
+#endif
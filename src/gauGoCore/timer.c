@@ -6,6 +6,55 @@
 
 #include "timer.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TIMER_CYCLES() __rdtsc()
+#else
+#define TIMER_CYCLES() timer_coarseNanos()
+#define TIMER_COARSE_CYCLES
+#endif
+
+/**
+ * @brief Time spent measuring the cycle counter frequency (ns)
+ **/
+#define TIMER_CALIBRATION 5000000LL
+
+/**
+ * @brief Cycle counter ticks per millisecond (0: not measured yet)
+ **/
+static double cyclesPerMilli = 0.0;
+
+/**
+ * @brief Reads the monotonic clock
+ *
+ * @return The time (ns)
+ **/
+static long long timer_nanos()
+{
+  struct timespec now;
+  clock_gettime( CLOCK_MONOTONIC, &now );
+  return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+#ifdef TIMER_COARSE_CYCLES
+/**
+ * @brief Reads the coarse monotonic clock, the fallback for the
+ * cycle counter (a few milliseconds resolution, but very cheap)
+ *
+ * @return The time (ns)
+ **/
+static unsigned long long timer_coarseNanos()
+{
+  struct timespec now;
+#ifdef CLOCK_MONOTONIC_COARSE
+  clock_gettime( CLOCK_MONOTONIC_COARSE, &now );
+#else
+  clock_gettime( CLOCK_MONOTONIC, &now );
+#endif
+  return now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+#endif
+
 void Timer_initialize( Timer* timer )
 {
   timer->elapsed = 0;
@@ -17,7 +66,7 @@ void Timer_initialize( Timer* timer )
  **/
 void Timer_start( Timer* timer )
 {
-  timer->startTime = clock();
+  timer->startTime = timer_nanos();
   timer->running = 1;
 }
 
@@ -26,8 +75,8 @@ void Timer_start( Timer* timer )
  **/
 void Timer_stop( Timer* timer )
 {
-  clock_t now = clock();
-  timer->elapsed += (double)(now - timer->startTime) / CLOCKS_PER_SEC;
+  if( !timer->running ) return;
+  timer->elapsed += timer_nanos() - timer->startTime;
   timer->running = 0;
 }
 
@@ -46,8 +95,36 @@ void Timer_reset( Timer* timer )
  **/
 int Timer_getElapsedTime( Timer* timer )
 {
-  clock_t now = clock();
-  double millis = (double)(now - timer->startTime)*1000 / CLOCKS_PER_SEC;
-  return timer->elapsed + millis;
+  return Timer_getElapsedNanos( timer ) / 1000000;
+}
+
+long long Timer_getElapsedNanos( Timer* timer )
+{
+  if( !timer->running ) return timer->elapsed;
+  return timer->elapsed + timer_nanos() - timer->startTime;
 }
 
+void CycleTimer_calibrate()
+{
+  if( cyclesPerMilli != 0.0 ) return;
+
+  // Measure the cycle counter frequency against the monotonic clock
+  long long start = timer_nanos(), now;
+  unsigned long long startCycles = TIMER_CYCLES();
+  do{
+    now = timer_nanos();
+  } while( now - start < TIMER_CALIBRATION );
+  cyclesPerMilli = (double)(TIMER_CYCLES() - startCycles) 
+    * 1000000.0 / (now - start);
+}
+
+void CycleTimer_start( CycleTimer* timer )
+{
+  CycleTimer_calibrate();
+  timer->startCycles = TIMER_CYCLES();
+}
+
+int CycleTimer_getElapsedTime( CycleTimer* timer )
+{
+  return (TIMER_CYCLES() - timer->startCycles) / cyclesPerMilli;
+}
@@ -2,7 +2,13 @@
  * @file timer.h
  * @brief Timer utility
  *
+ * Timers measure wall-clock time with a monotonic clock, so that
+ * they are not affected by clock changes, nor by the number of
+ * threads running.
+ *
  **/
+#ifndef TIMER_H
+#define TIMER_H
 
 #include <time.h>
 #include <stdio.h>
@@ -12,17 +18,29 @@
  **/
 typedef struct Timer
 {
-  // Time of last time the timer got started (or resumed)
-  clock_t startTime;
+  // Time of last time the timer got started (or resumed) (ns)
+  long long startTime;
 
-  // Total elapsed time
-  int elapsed;
+  // Total elapsed time until last stop (ns)
+  long long elapsed;
 
   // Running state
   int running;
 
 } Timer;
 
+/**
+ * A coarse timer based on the processor's cycle counter, much 
+ * cheaper to read than Timer, for deadline checks in hot loops.
+ * Falls back to a coarse monotonic clock without cycle counter.
+ **/
+typedef struct CycleTimer
+{
+  // Cycle count when the timer got started
+  unsigned long long startCycles;
+
+} CycleTimer;
+
 /**
  * @brief Initializes timer to default state
  **/
@@ -44,6 +62,31 @@ void Timer_stop( Timer* timer );
 void Timer_reset( Timer* timer );
 
 /**
- * @brief Gets current elapsed time
+ * @brief Gets current elapsed time (ms)
  **/
 int Timer_getElapsedTime( Timer* timer );
+
+/**
+ * @brief Gets current elapsed time (ns)
+ **/
+long long Timer_getElapsedNanos( Timer* timer );
+
+/**
+ * @brief Measures the cycle counter frequency (a few milliseconds),
+ * unless already done.  Must be called before several threads use
+ * cycle timers.
+ **/
+void CycleTimer_calibrate();
+
+/**
+ * @brief Starts a cycle timer.  The cycle counter frequency
+ * is measured at the first start if not calibrated yet.
+ **/
+void CycleTimer_start( CycleTimer* timer );
+
+/**
+ * @brief Gets the approximate elapsed time since the start (ms)
+ **/
+int CycleTimer_getElapsedTime( CycleTimer* timer );
+
+#endif
@@ -5,6 +5,7 @@
  **/
 #include "uctSearch.h"
 #include "crash.h"
+#include "priors.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -44,6 +45,17 @@ Color UCTSearch_playSimulation( UCTSearch* search, UCTNode* node,
  **/
 UCTNode* UCTSearch_selectUCT( UCTSearch* search, UCTNode* pos );
 
+/**
+ * @brief Obtains how many of the best ranked children of a node can
+ * be selected (progressive widening): wideningChildren at first, one
+ * more every time the node's playouts are multiplied by wideningGrowth
+ *
+ * @param search The search
+ * @param pos The node
+ * @return The number of eligible children
+ **/
+int UCTSearch_eligibleChildren( UCTSearch* search, UCTNode* pos );
+
 /**
  * @brief Create all legal children position of current board state 
  * and stores them in the tree
@@ -55,18 +67,29 @@ UCTNode* UCTSearch_selectUCT( UCTSearch* search, UCTNode* pos );
 void UCTSearch_createChildren( UCTSearch* search, UCTNode* pos, int depth );
 
 void UCTSearch_initialize( UCTSearch* search, Board* board, UCTTree* tree, 
-			   POLICY policy, STOPPER stopper, Options* options,
-			   HashKey lastBoards[SUPERKO_HISTORY_MAX])
+			   Policy* policy, STOPPER stopper, Options* options,
+			   HashKey* history, int historyNum )
 {
   search->root = *board;
   search->tree = tree;
   search->policy = policy;
   search->stopper = stopper;
   search->options = options;
-  search->lastBoards_next = 0;
-  memcpy(search->rootLastBoards, lastBoards, sizeof(search->lastBoards));
+
+  HashSet_clear( &search->pathHashes );
+  for( int h=0; h<historyNum; h++ ){
+    HashSet_push( &search->pathHashes, history[h] );
+  }
+  search->rootPathHashesNum = search->pathHashes.pushedNum;
+
+  PlayoutStats_clear( &search->stats );
 
   Timer_initialize( &search->timer );
+  search->maxTime = 0;
+  search->interrupt = NULL;
+  search->out = stdout;
+  search->analysisInterval = 0;
+  search->nextAnalysis = 0;
 }
 
 INTERSECTION UCTSearch_search( UCTSearch* search )
@@ -82,18 +105,17 @@ INTERSECTION UCTSearch_search( UCTSearch* search )
   int simulations = 0;
   Board boardCopy;
 
-  // Starts timer
+  // Starts timers
   Timer_start( &search->timer );
+  CycleTimer_start( &search->cycleTimer );
 
   // Simulate until stopper signals to stop
   do{
     // Copy the board
     Board_copy( &boardCopy, &search->root );
     search->board = &boardCopy;
-    // Copy last boards
-    memcpy(search->lastBoards, search->rootLastBoards, 
-	   sizeof(search->lastBoards));
-    search->lastBoards_next = 0;
+    // Forget previous simulation's tree path
+    HashSet_popTo( &search->pathHashes, search->rootPathHashesNum );
 
     // Play one playout from the most UCT-RAVE promising node
     unsigned char playedMoves[MAX_INTERSECTION_NUM];
@@ -103,7 +125,8 @@ INTERSECTION UCTSearch_search( UCTSearch* search )
 			     0, 0);
 
     simulations++;
-  } while(!(*(search->stopper))(search, simulations));
+  } while(!(search->interrupt && *search->interrupt)
+	  && !(*(search->stopper))(search, simulations));
 
   INTERSECTION pv[MAX_INTERSECTION_NUM];
   UCTTree_getPv( pv, &search->tree->root );
@@ -111,10 +134,10 @@ INTERSECTION UCTSearch_search( UCTSearch* search )
   return pv[0];
 }
 
-void UCTSearch_printSearchInfoHeader()
+void UCTSearch_printSearchInfoHeader( UCTSearch* search )
 {
-  printf("#  %-8s %-10s %-8s %-5s %-5s   %s\n", 
-	 "time", "playouts", "pps", "komi", "wr", "pv");
+  fprintf(search->out, "#  %-8s %-10s %-8s %-5s %-5s   %s\n", 
+	  "time", "playouts", "pps", "komi", "wr", "pv");
 }
 
 void UCTSearch_printSearchInfo( UCTSearch* search )
@@ -123,11 +146,11 @@ void UCTSearch_printSearchInfo( UCTSearch* search )
   search->board = &boardCopy;
 
   int elapsedMillis = Timer_getElapsedTime( &search->timer );
-  int pps = (search->tree->root.played*1000) / elapsedMillis; 
+  int pps = (search->tree->root.played*1000) / MAX(elapsedMillis, 1); 
   float wr = (float)search->tree->root.winsBlack / search->tree->root.played;
-  printf("#  %-8d %-10d %-8d %-5.1f %-5.2f   ",
-	 elapsedMillis, search->tree->root.played, pps, 
-	 search->options->komi, wr );
+  fprintf(search->out, "#  %-8d %-10d %-8d %-5.1f %-5.2f   ",
+	  elapsedMillis, search->tree->root.played, pps, 
+	  search->options->komi, wr );
 
   // Gets pv
   INTERSECTION pv[MAX_INTERSECTION_NUM];
@@ -138,9 +161,61 @@ void UCTSearch_printSearchInfo( UCTSearch* search )
 
     char str[5];
     Board_intersectionName( search->board, pv[i], str );
-    printf("%s ", str);
+    fprintf(search->out, "%s ", str);
+  }
+  fprintf(search->out, "\n");
+}
+
+/**
+ * @brief Orders tree nodes by decreasing number of playouts
+ **/
+int uctSearch_playedCmp( const void* a, const void* b )
+{
+  return (*(UCTNode**)b)->played - (*(UCTNode**)a)->played;
+}
+
+void UCTSearch_printAnalysis( UCTSearch* search )
+{
+  Board* board = &search->root;
+  UCTNode* root = &search->tree->root;
+  
+  // Visited children, most visited first
+  UCTNode* children[MAX_INTERSECTION_NUM+1];
+  int childrenNum = 0;
+  foreach_child( root ){
+    if( child->played ) children[childrenNum++] = child;
+  }
+  if( !childrenNum ) return;
+  qsort( children, childrenNum, sizeof(*children), &uctSearch_playedCmp );
+
+  for( int c=0; c<childrenNum; c++ ){
+    UCTNode* node = children[c];
+    char str[5];
+    Board_intersectionName( board, node->move, str );
+
+    // Win rates for the player to move
+    float wr = (float)node->winsBlack / node->played;
+    float amafWr = node->AMAFplayed ? 
+      (float)node->AMAFwinsBlack / node->AMAFplayed : 0.0f;
+    if( board->turn == WHITE ){
+      wr = 1.0f - wr;
+      amafWr = node->AMAFplayed ? 1.0f - amafWr : 0.0f;
+    }
+    fprintf(search->out, 
+	    "%sinfo move %s visits %d winrate %.4f amafvisits %d "
+	    "amafwinrate %.4f pv %s", c ? " " : "", str, node->played, wr, 
+	    node->AMAFplayed, amafWr, str);
+
+    // Pv after the move
+    INTERSECTION pv[MAX_INTERSECTION_NUM];
+    UCTTree_getPv( pv, node );
+    for( int i=0; i<MAX_INTERSECTION_NUM; i++ ){
+      if( !pv[i] ) break;
+      Board_intersectionName( board, pv[i], str );
+      fprintf(search->out, " %s", str);
+    }
   }
-  printf("\n");
+  fprintf(search->out, "\n");
 }
 
 void UCTSearch_printSearchGoguiGfx( UCTSearch* search )
@@ -149,7 +224,7 @@ void UCTSearch_printSearchGoguiGfx( UCTSearch* search )
   search->board = &boardCopy;
   
   int elapsedMillis = Timer_getElapsedTime( &search->timer );
-  int pps = (search->tree->root.played*1000) / elapsedMillis; 
+  int pps = (search->tree->root.played*1000) / MAX(elapsedMillis, 1); 
   float wr = (float)search->tree->root.winsBlack / search->tree->root.played;
   fprintf(stderr, "gogui-gfx: TEXT %-3.2fs %dpo %dpps %-3.1fk %-4.2fwr\n",
 	 (float)elapsedMillis/1000.0f, search->tree->root.played, pps, 
@@ -188,8 +263,11 @@ Color UCTSearch_playSimulation( UCTSearch* search, UCTNode* pos,
     }
 
     // Play random game
-    winner = (*(search->policy))(search->board, search->iter, 
-				 search->options->komi, playedMoves);
+    winner = (*(search->policy->playout))(search->policy, 
+					  search->board, search->iter, 
+					  search->options->komi, playedMoves);
+    PlayoutStats_add( &search->stats, search->board, search->iter, 
+		      winner, search->policy->finished, NULL );
   }
   else{
 
@@ -215,9 +293,8 @@ Color UCTSearch_playSimulation( UCTSearch* search, UCTNode* pos,
       Board_play( search->board, bestchild->move );
     }
 
-    // Save board hash to last boards (superko check)
-    search->lastBoards[search->lastBoards_next] = search->board->hashKey;
-    search->lastBoards_next = (search->lastBoards_next+1) % SUPERKO_HISTORY_MAX;
+    // Save board hash to the path (superko check)
+    HashSet_push( &search->pathHashes, search->board->hashKey );
 
     // Recurse
     winner = UCTSearch_playSimulation( search, bestchild, 
@@ -244,45 +321,76 @@ Color UCTSearch_playSimulation( UCTSearch* search, UCTNode* pos,
 
 void UCTSearch_createChildren( UCTSearch* search, UCTNode* pos, int depth )
 {      
+  // Legal children, best ranked first (see progressive widening)
+  UCTNode* children[MAX_INTERSECTION_NUM+1];
+  float ranks[MAX_INTERSECTION_NUM+1];
+  int numChildren = 0;
+
   // Browses all legal children
-  UCTNode* childNode = NULL;
   int empty;
-  int numChildren = 0;
   for(EMPTIES(search->board)){
     empty = EMPTYI(search->board);
 
     if( Board_isLegalNoEyeFilling( search->board, empty ) ){
 
       // Superko check
-      HashKey childHash = Board_childHash( search->board, i );
-      int superko = 0;
-      for(int k=0; k<SUPERKO_HISTORY_MAX; k++){
-	if( childHash == search->lastBoards[k] ) {
-	  superko = 1;
-	  break;
-	}
-      }
-      if( superko ) continue;
+      HashKey childHash = Board_childHash( search->board, empty );
+      if( HashSet_contains( &search->pathHashes, childHash ) ) continue;
 
       UCTNode* newNode = UCTTree_newNode( search->tree );
       newNode->move = empty;
 
-      // Add as first child or brother of prev node
-      if( childNode == NULL ) pos->firstChild = newNode;
-      else childNode->nextSibiling = newNode;
-      childNode = newNode;
-      numChildren++;
+      // Prior knowledge, as virtual playouts
+      float rank = 0.5f;
+      if( search->options->priorVisits ){
+	Prior prior;
+	Priors_evaluate( search->board, empty, &search->stats,
+			 search->options->priorVisits, &prior );
+	newNode->priorPlayed = prior.played;
+	newNode->priorWinsBlack = search->board->turn == BLACK ?
+	  prior.wins : prior.played - prior.wins;
+	rank = (float)prior.wins / prior.played;
+      }
+
+      // Insert by rank (after children with the same rank)
+      int c = numChildren++;
+      while( c > 0 && ranks[c-1] < rank ){
+	children[c] = children[c-1];
+	ranks[c] = ranks[c-1];
+	c--;
+      }
+      children[c] = newNode;
+      ranks[c] = rank;
     }
   }
 
-        
-  // Create pass node
+  // Create pass node, ranked last
   if( numChildren <= UCT_PASSNODE_MAX_CHILDREN ){
     UCTNode* newNode = UCTTree_newNode( search->tree );
     newNode->move = PASS;
-    if( childNode == NULL ) pos->firstChild = newNode;
-    else childNode->nextSibiling = newNode;
+    children[numChildren++] = newNode;
+  }
+
+  // Link children in rank order
+  pos->firstChild = children[0];
+  for( int c=0; c<numChildren-1; c++ ){
+    children[c]->nextSibiling = children[c+1];
+  }
+}
+
+int UCTSearch_eligibleChildren( UCTSearch* search, UCTNode* pos )
+{
+  Options* options = search->options;
+
+  // Children are only ranked with prior knowledge
+  if( options->wideningChildren <= 0 || options->wideningGrowth <= 1.0f
+      || !options->priorVisits ){
+    return MAX_INTERSECTION_NUM;
   }
+  if( pos->played <= 1 ) return options->wideningChildren;
+
+  return options->wideningChildren 
+    + (int)(log(pos->played) / log(options->wideningGrowth));
 }
 
 UCTNode* UCTSearch_selectUCT( UCTSearch* search, UCTNode* pos )
@@ -290,9 +398,11 @@ UCTNode* UCTSearch_selectUCT( UCTSearch* search, UCTNode* pos )
   float bestUCT = -100.0f;
   INTERSECTION bestMove = PASS;
 
-  // Browses all children of current position
+  // Browses the eligible children of current position
+  int eligible = UCTSearch_eligibleChildren( search, pos );
   UCTNode* bestChild = NULL;
   foreach_child(pos){
+    if( eligible-- <= 0 ) break;
     float uctValue = UCTNode_evaluateUCT( 
 					 child, 
 					 pos, 
@@ -310,23 +420,27 @@ UCTNode* UCTSearch_selectUCT( UCTSearch* search, UCTNode* pos )
 float UCTNode_evaluateUCT( const UCTNode* node, const UCTNode* parent, 
 			   Color turn, float UCTK )
 {
+  // Prior knowledge counts as played
+  int played = node->played + node->priorPlayed;
+  int winsBlack = node->winsBlack + node->priorWinsBlack;
+
   // Random huge value for unexplored nodes
   float amaf = ((float)node->AMAFwinsBlack / (node->AMAFplayed+1) );
-  if( node->played == 0 ) 
+  if( played == 0 ) 
     return 10000.0f + ((turn==BLACK) ? amaf : 1.0f-amaf);
 
   // AMAF weight
-  float beta = sqrt(500.0/(3*node->played+500));
+  float beta = sqrt(500.0/(3*played+500));
   float value;
-  float uct = UCTK*sqrt( log(parent->played) / (5*node->played) );
+  float uct = UCTK*sqrt( log(parent->played) / (5*played) );
 
   switch( turn ){
   case BLACK:
-    value = (((float)node->winsBlack / node->played));
+    value = (((float)winsBlack / played));
     break;
     
   case WHITE:
-    value = (1.0f - ((float)node->winsBlack / node->played));
+    value = (1.0f - ((float)winsBlack / played));
     amaf = 1.0f - amaf;
     break;
 
@@ -13,21 +13,16 @@
 #include "global_defs.h"
 #include "board.h"
 #include "hashTable.h"
+#include "hashSet.h"
 #include "options.h"
 #include "uctTree.h"
 #include "timer.h"
+#include "policies.h"
 
 #include <stdio.h>
 
 struct UCTSearch;
 
-/**
- * @brief Function that transform an arbitrary go board 
- * into a finished game (i.e. performs a playout)
- **/
-typedef Color (*POLICY)(Board*, BoardIterator*, float, 
-			unsigned char* playedMoves);
-
 /**
  * @brief Function that determines whether to stop UCT 
  * search or not (The number of total playouts 
@@ -45,22 +40,40 @@ typedef struct UCTSearch
   // Incremental/temporary handles (change along search)
   Board* board;
   BoardIterator* iter;  
-  // Last N board hashes for superko check in uct tree
-  HashKey lastBoards[SUPERKO_HISTORY_MAX];
-  int lastBoards_next;
+  // Hashes of the game and current tree path positions (superko)
+  HashSet pathHashes;
 
   // Singleton-like data handles (constant along search)
   Board root;
-  HashKey rootLastBoards[SUPERKO_HISTORY_MAX];
+  int rootPathHashesNum;
   UCTTree* tree;
-  POLICY policy;
+  Policy* policy;
   STOPPER stopper;
   Options* options;
   Timer timer;
+  CycleTimer cycleTimer;
+
+  // Time allowed for the search, for time-based stoppers (ms, 0: none)
+  int maxTime;
+
+  // Set from another thread to stop the search after the current
+  // simulation (NULL: never)
+  volatile int* interrupt;
+
+  // Analysis output: time between two lines, and time of the 
+  // next line (ms)
+  int analysisInterval;
+  int nextAnalysis;
+
+  // Stream for search info and analysis (stdout by default)
+  FILE* out;
 
   // UCT exploration/exploitation parameter
   float UCTK;
 
+  // Ownership and criticality from the search's playouts
+  PlayoutStats stats;
+
 } UCTSearch;
 
 /**
@@ -69,14 +82,16 @@ typedef struct UCTSearch
  * @param search The search to initialize
  * @param board The board position
  * @param tree An initialized UCT tree (can be non-empty, care for the size though)
- * @param policy A playout policy
+ * @param policy A playout policy instance (not shared with other searches)
  * @param stopper Function to stop the search arbitrarily
  * @param options Search options
- * @param lastBoards Last boards' hash keys to avoid superko
+ * @param history Hash keys of all the game positions up to the
+ * current one, to avoid superko
+ * @param historyNum Number of hash keys in history
  **/
 void UCTSearch_initialize( UCTSearch* search, Board* board, UCTTree* tree, 
-			   POLICY policy, STOPPER stopper, Options* options,
-			   HashKey lastBoards[SUPERKO_HISTORY_MAX]);
+			   Policy* policy, STOPPER stopper, Options* options,
+			   HashKey* history, int historyNum );
 
 /**
  * @brief Performs an UCT search from the specified board position, and using the
@@ -84,7 +99,7 @@ void UCTSearch_initialize( UCTSearch* search, Board* board, UCTTree* tree,
  * the currently UCT-RAVE most promising node, using the specified policy.
  *
  * After every playout, stopper is checked in order to determine whether to stop the search
- * or continue.
+ * or continue.  The search also stops as soon as interrupt is set.
  *
  * When the search terminates, the intersection representing the best 
  * children of root position according only to the number of 
@@ -95,16 +110,29 @@ INTERSECTION UCTSearch_search( UCTSearch* search );
 
 /**
  * @brief Prints the header for search info (ASCII table format)
+ *
+ * @param search The search going on
  **/
-void UCTSearch_printSearchInfoHeader();
+void UCTSearch_printSearchInfoHeader( UCTSearch* search );
 
 /**
- * @brief Prints current search info to stdout (one line) in GTP comment format.
+ * @brief Prints current search info (one line) in GTP comment format.
  *
  * @param search The search going on
  **/
 void UCTSearch_printSearchInfo( UCTSearch* search );
 
+/**
+ * @brief Prints the statistics of all visited root children 
+ * in one line, most visited first, for analysis tools: 
+ * "info move M visits N winrate W amafvisits N amafwinrate W pv M M..."
+ * for every child.  Win rates are for the player to move, from 0 to 1.
+ * Nothing is printed (not even an empty line) before a child is visited.
+ *
+ * @param search The search going on
+ **/
+void UCTSearch_printAnalysis( UCTSearch* search );
+
 /**
  * @brief Prints current search info to stderr in the form 
  * of gogui live-gfx commands, showing info about current pv
@@ -37,6 +37,11 @@ typedef struct UCTNode
   
   /** Intersection to identify the move represented by this node*/
   INTERSECTION move;
+
+  /** Virtual wins given by prior knowledge */
+  unsigned short priorWinsBlack;
+  /** Virtual playouts given by prior knowledge */
+  unsigned short priorPlayed;
   
 } UCTNode;
 
@@ -134,7 +139,8 @@ void UCTNode_initialize( UCTNode* node );
 /**
  * @brief Evaluate a node based on its UCT-RAVE values 
  * (UCB standard formula extended with RAVE)
- * A node with no direct visits is always given maximum value
+ * Prior knowledge counts as visits.  A node with neither visits
+ * nor prior is always given maximum value
  *
  * @param node The node to evaluate UCT value
  * @param parent The parent of 'node'